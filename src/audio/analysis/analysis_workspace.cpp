@@ -0,0 +1,36 @@
+// ---------------------------------------------
+// Analysis Workspace Implementation
+// ---------------------------------------------
+#include "analysis_workspace.h"
+#include "logging.h"
+#include <string>
+
+bool AnalysisWorkspace::Configure(size_t fft_size) {
+    if (fft_size == fft_size_) {
+        return false;
+    }
+    fft_size_ = fft_size;
+    const size_t half_fft_size = fft_size / 2;
+    const bool use_real_fft = (fft_size % 2 == 0);
+
+    frame.assign(fft_size, 0.0f);
+    fft_in.assign(fft_size, 0.0f);
+    complex_in.assign(use_real_fft ? 0 : fft_size, kiss_fft_cpx{});
+    fft_out.assign(use_real_fft ? half_fft_size + 1 : fft_size, kiss_fft_cpx{});
+    magnitudes.assign(half_fft_size, 0.0f);
+    resize_count_++;
+
+    LOG_DEBUG("[AnalysisWorkspace] Resized for fftSize=" + std::to_string(fft_size));
+    return true;
+}
+
+bool AnalysisWorkspace::Reserve(size_t frames) {
+    if (mono.size() >= frames) {
+        return false;
+    }
+    mono.resize(frames);
+    resize_count_++;
+
+    LOG_DEBUG("[AnalysisWorkspace] Grew packet buffer to " + std::to_string(frames) + " frames");
+    return true;
+}
@@ -0,0 +1,47 @@
+// ---------------------------------------------
+// Analysis Workspace
+// Preallocated scratch buffers for the real-time analysis path
+// ---------------------------------------------
+#pragma once
+#include <kiss_fft.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Scratch buffers reused by AudioAnalyzer for every packet and STFT frame.
+ *
+ * Buffers are sized by Configure() when frequency.fftSize changes and by Reserve()
+ * when a larger packet than ever before arrives; in steady state the analysis path
+ * does not touch the allocator.
+ */
+struct AnalysisWorkspace {
+    std::vector<float> mono;                // Mono downmix of the current packet (grow-only)
+    std::vector<float> frame;               // STFT frame handed to the spectrum stage
+    std::vector<kiss_fft_scalar> fft_in;    // Windowed FFT input
+    std::vector<kiss_fft_cpx> complex_in;   // Complex FFT input (odd sizes only)
+    std::vector<kiss_fft_cpx> fft_out;      // FFT output (N/2 + 1 bins, or N for odd sizes)
+    std::vector<float> magnitudes;          // Current frame magnitudes, swapped with the previous frame's
+
+    /**
+     * @brief Size the FFT buffers for a transform size
+     * @param fft_size Transform size
+     * @return True if the buffers were resized
+     */
+    bool Configure(size_t fft_size);
+
+    /**
+     * @brief Make sure the mono buffer can hold a packet
+     * @param frames Frames in the packet
+     * @return True if the buffer had to grow
+     */
+    bool Reserve(size_t frames);
+
+    size_t FftSize() const { return fft_size_; }
+
+    /// Number of times Configure() or Reserve() had to reallocate (diagnostics).
+    size_t ResizeCount() const { return resize_count_; }
+
+private:
+    size_t fft_size_ = 0;
+    size_t resize_count_ = 0;
+};
@@ -6,16 +6,18 @@
 #include "beat_detector.h"
 #include "beat_detector_simple_energy.h"
 #include "beat_detector_spectral_flux_auto.h"
+#include "simd_kernels.h"
 #include "logging.h"
+#include "allocation_counter.h"
 #include "configuration/configuration_manager.h"
 #include "../core/audio_format_utils.h"
+#include "channel_layout.h"
 #include "../core/constants.h"
 using Listeningway::ConfigurationManager;
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <mutex>
-#include <kiss_fft.h>
 #include <memory>
 #include <complex>
 #include <sstream>
@@ -31,13 +33,25 @@ std::string formatFloat(float value, int precision = 6) {
 // Global instance of AudioAnalyzer
 AudioAnalyzer g_audio_analyzer;
 
-// Standard standalone function to analyze audio buffers (used by audio_capture.cpp)
-void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels, AudioAnalysisData& out) {
-    const auto config = Listeningway::ConfigurationManager::Snapshot(); // Thread-safe snapshot for audio capture threads
+// Packets after a rebuild whose allocations are not counted: each of the three published
+// frame slots grows to the new band/FFT sizes on its first reuse
+static constexpr size_t FRAME_SLOT_WARMUP = 3;
+
+// One-Euro settings of one output signal
+static OneEuroParams SmoothingParams(float min_cutoff, float beta, const Listeningway::Configuration& config) {
+    OneEuroParams params;
+    params.min_cutoff = min_cutoff;
+    params.beta = beta;
+    params.derivative_cutoff = config.smoothing.derivativeCutoff;
+    return params;
+}
+
+// Volume and spatialization of one captured packet (called by AnalyzeAudioBuffer with mutex_ held)
+void AudioAnalyzer::AnalyzeLevels(const float* data, size_t numFrames, size_t numChannels, const PacketEnergy& energy,
+                                  const Listeningway::Configuration& config, AudioAnalysisData& out) {
     
     // DEBUG: Validate input data
-    static int input_debug_counter = 0;
-    if (++input_debug_counter % 1000 == 0) {
+    if (++level_state_.debug.input % 1000 == 0) {
         float sample_min = 1000.0f, sample_max = -1000.0f;
         size_t sample_count = std::min(numFrames * numChannels, size_t(100)); // Check first 100 samples
         for (size_t i = 0; i < sample_count; i++) {
@@ -47,17 +61,13 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
             ", Channels=" + std::to_string(numChannels) + 
             ", SampleRange=[" + std::to_string(sample_min) + ", " + std::to_string(sample_max) + "]");
     }
-      // Calculate volume (RMS)
-    float sum_squares = 0.0f;
-    for (size_t i = 0; i < numFrames * numChannels; i++) {
-        sum_squares += data[i] * data[i];
-    }
+    // Calculate volume (RMS) from the packet energy gathered by the fused kernel
+    const float sum_squares = energy.total;
     float rms = std::sqrt(sum_squares / (numFrames * numChannels));
     out.volume = std::min(1.0f, rms * config.frequency.amplifier); // Use amplifier for normalization
     
     // DEBUG: Check for potential numerical issues
-    static int numerical_debug_counter = 0;
-    if (++numerical_debug_counter % 500 == 0 && sum_squares > 0.0f) {
+    if (++level_state_.debug.numerical % 500 == 0 && sum_squares > 0.0f) {
         float avg_square = sum_squares / (numFrames * numChannels);        LOG_INFO("[NUMERICAL_DEBUG] SumSquares=" + std::to_string(sum_squares) + 
             ", AvgSquare=" + std::to_string(avg_square) + 
             ", RMS=" + std::to_string(rms) + 
@@ -73,338 +83,22 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
         }
     }
     
-    // Resize frequency bands vector if needed
-    if (out.freq_bands.size() != config.frequency.bands) {
-        out.freq_bands.resize(config.frequency.bands, 0.0f);
-        out.raw_freq_bands.resize(config.frequency.bands, 0.0f);
-    }
-    
-    // Prepare FFT data
-    const size_t fft_size = config.frequency.fftSize;
-    const size_t half_fft_size = fft_size / 2;
-    
-    // Create FFT configuration
-    kiss_fft_cfg fft_cfg = kiss_fft_alloc(fft_size, 0, nullptr, nullptr);
-    if (!fft_cfg) {
-        LOG_ERROR("[AudioAnalyzer] Failed to allocate FFT configuration");
-        return;
-    }
-    
-    // Prepare input and output arrays for FFT
-    std::vector<kiss_fft_cpx> fft_in(fft_size);
-    std::vector<kiss_fft_cpx> fft_out(fft_size);
-    std::vector<float> magnitudes(half_fft_size);
-    
-    // Zero out the input array
-    std::fill(fft_in.begin(), fft_in.end(), kiss_fft_cpx{0.0f, 0.0f});
-    
-    // Average all channels and copy to FFT input buffer with Hann window
-    // Only copy up to fft_size frames, or pad with zeros if we have fewer
-    const size_t frames_to_process = std::min(numFrames, fft_size);
-    for (size_t i = 0; i < frames_to_process; i++) {
-        float sample = 0.0f;
-        
-        // Average all channels
-        for (size_t ch = 0; ch < numChannels; ch++) {
-            sample += data[i * numChannels + ch];
-        }
-        sample /= numChannels;
-        
-        // Apply Hann window: 0.5 * (1 - cos(2π*n/(N-1)))
-        const float window = 0.5f * (1.0f - std::cos(2.0f * 3.14159f * i / (fft_size - 1)));
-        fft_in[i].r = sample * window;
-        fft_in[i].i = 0.0f;
-    }
-    
-    // Execute FFT
-    kiss_fft(fft_cfg, fft_in.data(), fft_out.data());
-    
-    // Calculate magnitude of each FFT bin
-    for (size_t i = 0; i < half_fft_size; i++) {
-        // |c| = sqrt(real² + imag²)
-        magnitudes[i] = std::sqrt(fft_out[i].r * fft_out[i].r + fft_out[i].i * fft_out[i].i);
-    }
-    
-    // Calculate spectral flux (difference from previous magnitudes)
-    float flux = 0.0f;
-    float flux_low = 0.0f;
-    const size_t low_freq_cutoff = half_fft_size / 4; // Bottom 25% of spectrum
-    
-    if (!out._prev_magnitudes.empty()) {
-        for (size_t i = 0; i < half_fft_size; i++) {
-            // Only count positive differences (increases in energy)
-            float diff = std::max(0.0f, magnitudes[i] - out._prev_magnitudes[i]);
-            flux += diff;
-            
-            // Also calculate flux for low frequencies only (for bass detection)
-            if (i < low_freq_cutoff) {
-                flux_low += diff;
-            }
-        }
-        
-        // Store the flux values for beat detection
-        out._flux_avg = flux / half_fft_size;
-        out._flux_low_avg = flux_low / low_freq_cutoff;
-    }
-    else {
-        // Initialize previous magnitudes the first time
-        out._prev_magnitudes.resize(half_fft_size);
-        out._flux_avg = 0.0f;
-        out._flux_low_avg = 0.0f;
-    }
-    
-    // Store current magnitudes for next frame
-    out._prev_magnitudes = magnitudes;
-    
-    // Populate frequency bands using proper mapping according to settings
-    const size_t bands = config.frequency.bands;
-    const bool use_log_scale = config.frequency.logScaleEnabled;
-    const float min_freq = config.frequency.minFreq;
-    const float max_freq = config.frequency.maxFreq;
-    const float log_strength = config.frequency.logStrength;
-    // TODO: Add fftSize, bandNorm, sample_rate to Configuration if needed, or define locally/with constants
-    const float nyquist_freq = config.sample_rate * 0.5f;
-    
-    // Ensure min and max are within sensible ranges for the FFT size
-    const float effective_min_freq = std::max(20.0f, std::min(min_freq, nyquist_freq * 0.5f));
-    const float effective_max_freq = std::min(nyquist_freq, std::max(max_freq, effective_min_freq * 2.0f));
-    
-    // Pre-calculate bin frequencies
-    std::vector<float> bin_freqs(half_fft_size);
-    for (size_t i = 0; i < half_fft_size; i++) {
-        bin_freqs[i] = static_cast<float>(i) * nyquist_freq / half_fft_size;
-    }
-    
-    // Clear the frequency bands before populating
-    std::fill(out.freq_bands.begin(), out.freq_bands.end(), 0.0f);
-    
-    // FIXED IMPLEMENTATION: Addressing band gaps with more uniform distribution
-    // Calculate band boundaries that ensure every FFT bin contributes to at least one band
-    std::vector<float> band_edges(bands + 1);
-    if (use_log_scale) {
-        // Always use equal log steps for band edges
-        const float log_min = std::log10(effective_min_freq);
-        const float log_max = std::log10(effective_max_freq);
-        const float log_range = log_max - log_min;
-        for (size_t i = 0; i <= bands; i++) {
-            float t = static_cast<float>(i) / bands;
-            band_edges[i] = std::pow(10.0f, log_min + t * log_range);
-        }
-    } else {
-        // Linear frequency distribution - equally spaced bands
-        for (size_t i = 0; i <= bands; i++) {
-            band_edges[i] = effective_min_freq + 
-                (effective_max_freq - effective_min_freq) * static_cast<float>(i) / bands;
-        }
-    }
-    
-    // Ensure band edges are monotonically increasing and within valid range
-    for (size_t i = 0; i <= bands; i++) {
-        band_edges[i] = std::max(effective_min_freq, std::min(effective_max_freq, band_edges[i]));
-        if (i > 0) {
-            band_edges[i] = std::max(band_edges[i], band_edges[i-1] + 1.0f);
-        }
-    }
-    
-    // Create a mapping of which FFT bins contribute to which bands
-    // This is critical to ensure no gaps in the visualization
-    std::vector<std::vector<size_t>> band_bins(bands);
-    
-    // First, determine which band each FFT bin belongs to primarily
-    for (size_t i = 1; i < half_fft_size; i++) {
-        float bin_freq = bin_freqs[i];
-        
-        // Skip if below minimum frequency
-        if (bin_freq < band_edges[0]) {
-            continue;
-        }
-        
-        // Find the appropriate band for this bin
-        for (size_t b = 0; b < bands; b++) {
-            if (bin_freq >= band_edges[b] && bin_freq < band_edges[b + 1]) {
-                band_bins[b].push_back(i);
-                break;
-            }
-        }
-    }
-    
-    // Ensure every band has at least one bin (fix gaps)
-    for (size_t b = 0; b < bands; b++) {
-        if (band_bins[b].empty()) {
-            // This band has no bins assigned - find the closest bin
-            float band_center = (band_edges[b] + band_edges[b + 1]) * 0.5f;
-            size_t closest_bin = 1;
-            float min_distance = std::numeric_limits<float>::max();
-            
-            for (size_t i = 1; i < half_fft_size; i++) {
-                float distance = std::abs(bin_freqs[i] - band_center);
-                if (distance < min_distance) {
-                    min_distance = distance;
-                    closest_bin = i;
-                }
-            }
-            
-            // Assign this bin to the band
-            band_bins[b].push_back(closest_bin);
-        }
-    }
-    
-    // Process each frequency band
-    for (size_t band = 0; band < bands; band++) {
-        // Calculate energy for this band from its assigned bins
-        float energy_sum = 0.0f;
-        
-        // Sum energy from all bins assigned to this band
-        for (size_t bin_idx : band_bins[band]) {
-            energy_sum += magnitudes[bin_idx];
-        }
-        
-        // Average the energy across all contributing bins
-        float band_value = 0.0f;
-        if (!band_bins[band].empty()) {
-            band_value = energy_sum / band_bins[band].size();
-        }
-        
-        // Store the raw (unmodified) band value for beat detection
-        out.raw_freq_bands[band] = std::min(1.0f, band_value * config.frequency.bandNorm);
-        
-        // Calculate equalizer multiplier for visualization
-        float equalizer_multiplier = 1.0f;
-        
-        // Calculate band center frequency - needed for both logarithmic and linear modes
-        float band_center = std::sqrt(band_edges[band] * band_edges[band + 1]);
-        
-        // Apply 5-band equalizer system
-        // Map band to normalized position from 0.0 to 1.0 across the frequency range
-        float normalized_pos = static_cast<float>(band) / (bands - 1);
-        
-        // Calculate contributions from each modifier based on position
-        // Apply bell curve (Gaussian) weighting to each modifier's influence
-        
-        // Bell curve centers for 5 bands (evenly distributed)
-        const float centers[5] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
-        
-        // Width of the bell curve from user settings (smaller = sharper peaks, larger = more overlap)
-        const float bell_width = config.frequency.equalizerWidth;
-        
-        // Apply bell curves from all 5 modifiers with position-based weighting
-        float total_weight = 0.0f;
-        float weighted_modifier = 0.0f;
-        
-        // Calculate weighted contribution from each modifier
-        for (int i = 0; i < 5; i++) {
-            // Calculate Gaussian weight: e^(-(x^2)/(2*sigma^2))
-            float distance = normalized_pos - centers[i];
-            float bell_value = std::exp(-(distance * distance) / (2.0f * bell_width * bell_width));
-            
-            // Get the corresponding modifier value
-            float modifier_value = config.frequency.equalizerBands[i];
-            
-            weighted_modifier += bell_value * modifier_value;
-            total_weight += bell_value;
-        }
-        
-        // Normalize the weighted modifier if we have any weight
-        if (total_weight > 0.0f) {
-            equalizer_multiplier = weighted_modifier / total_weight;
-        }
-        
-        // Apply the equalizer multiplier to the raw band value for visualization
-        out.freq_bands[band] = out.raw_freq_bands[band] * equalizer_multiplier;
-        // Apply logStrength as a logarithmic gain curve (only if log scale is enabled)
-        if (use_log_scale && log_strength != 0.0f) {
-            float gain = std::exp(static_cast<float>(band + 1) * (log_strength/3));
-            out.freq_bands[band] *= gain;
-        }
-    }
-    
     // --- Audio Spatialization: Calculate left/right volume and pan ---
-    // Calculate per-channel RMS for left/right (and pan)
-    float sum_left = 0.0f, sum_right = 0.0f, sum_center = 0.0f;
-    float sum_side_left = 0.0f, sum_side_right = 0.0f;
-    float sum_rear_left = 0.0f, sum_rear_right = 0.0f;
-    float sum_total = 0.0f;
-    size_t count_left = 0, count_right = 0, count_center = 0;
-    size_t count_side_left = 0, count_side_right = 0, count_rear_left = 0, count_rear_right = 0;    // Get the audio format once outside the loop for efficiency
-    AudioFormat format = AudioFormatUtils::IntToFormat(static_cast<int>(numChannels));
-    
-    // Channel mapping: FL=0, FR=1, C=2, LFE=3, SL=4, SR=5, RL=6, RR=7 (ITU-R BS.775)
-    for (size_t i = 0; i < numFrames; ++i) {
-        for (size_t ch = 0; ch < numChannels; ++ch) {
-            float sample = data[i * numChannels + ch];
-            sum_total += sample * sample;
-            
-            // Simplified and more reliable channel identification for stereo
-            if (numChannels == 2) {
-                // For stereo: channel 0 = left, channel 1 = right
-                if (ch == 0) {
-                    sum_left += sample * sample;
-                    count_left++;
-                } else if (ch == 1) {
-                    sum_right += sample * sample;
-                    count_right++;
-                }
-            } else if (numChannels == 1) {
-                // For mono: single channel counts as both left and right
-                sum_left += sample * sample;
-                sum_right += sample * sample;
-                count_left++;
-                count_right++;
-            } else {
-                // For surround sound, use utility functions
-                if (AudioFormatUtils::IsLeftChannel(format, ch)) {
-                    sum_left += sample * sample;
-                    count_left++;
-                }
-                if (AudioFormatUtils::IsRightChannel(format, ch)) {
-                    sum_right += sample * sample;
-                    count_right++;
-                }
-                if (AudioFormatUtils::IsCenterChannel(format, ch)) {
-                    sum_center += sample * sample;
-                    count_center++;
-                }
-                if (AudioFormatUtils::IsSideChannel(format, ch)) {
-                    if (ch == 4 || ch == 6) { // SL channels
-                        sum_side_left += sample * sample;
-                        count_side_left++;
-                    } else { // SR channels
-                        sum_side_right += sample * sample;
-                        count_side_right++;
-                    }
-                }
-                if (AudioFormatUtils::IsRearChannel(format, ch)) {
-                    if (ch == 4) { // RL
-                        sum_rear_left += sample * sample;
-                        count_rear_left++;
-                    } else { // RR
-                        sum_rear_right += sample * sample;
-                        count_rear_right++;
-                    }
-                }
-            }
-        }
-    }    // Calculate RMS for each channel group    // For stereo, we should have exactly numFrames samples per channel
-    float rms_left, rms_right;
-      if (numChannels == 2) {
-        // For stereo, use a direct calculation to avoid any potential counting issues
-        float sum_left_direct = 0.0f, sum_right_direct = 0.0f;
-        for (size_t i = 0; i < numFrames; ++i) {
-            float left_sample = data[i * 2 + 0];   // Channel 0
-            float right_sample = data[i * 2 + 1];  // Channel 1
-            sum_left_direct += left_sample * left_sample;
-            sum_right_direct += right_sample * right_sample;
-        }
-        rms_left = std::sqrt(sum_left_direct / numFrames);
-        rms_right = std::sqrt(sum_right_direct / numFrames);
-        
+    // Fold the per-channel energies into speaker groups with the compile-time role table
+    // of this channel layout (dispatched once per buffer)
+    using namespace ChannelLayout;
+    const GroupLevels groups = GroupChannels(numChannels, energy, numFrames);
+    
+    // Calculate RMS for each channel group
+    const float rms_left = groups.rms[GroupLeft];
+    const float rms_right = groups.rms[GroupRight];
+    if (numChannels == 2) {
         // DEBUG: Log direct RMS calculation details
         if (rms_left + rms_right > 0.001f) {
-            static int rms_debug_counter = 0;
-            if (++rms_debug_counter % 200 == 0) {  // Log every 200th frame
+            if (++level_state_.debug.rms % 200 == 0) {  // Log every 200th frame
                 float balance = (rms_right - rms_left) / std::max(rms_right + rms_left, 0.000001f);                LOG_INFO("[RMS_DEBUG_DIRECT] Frames=" + std::to_string(numFrames) + 
-                    ", SumL=" + formatFloat(sum_left_direct, 8) + 
-                    ", SumR=" + formatFloat(sum_right_direct, 8) + 
+                    ", SumL=" + formatFloat(groups.sum[GroupLeft], 8) + 
+                    ", SumR=" + formatFloat(groups.sum[GroupRight], 8) + 
                     ", RMSL=" + formatFloat(rms_left, 8) + 
                     ", RMSR=" + formatFloat(rms_right, 8) + 
                     ", Balance=" + formatFloat(balance, 6));
@@ -417,27 +111,22 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
             }
         }
     } else {
-        // For other formats, use the counting approach
-        rms_left = count_left ? std::sqrt(sum_left / count_left) : 0.0f;
-        rms_right = count_right ? std::sqrt(sum_right / count_right) : 0.0f;
-        
         // DEBUG: Log channel mapping for non-stereo formats
-        static int mapping_debug_counter = 0;
-        if (++mapping_debug_counter % 300 == 0) {            LOG_INFO("[RMS_DEBUG_MAPPING] Channels=" + std::to_string(numChannels) + 
-                ", CountL=" + std::to_string(count_left) + 
-                ", CountR=" + std::to_string(count_right) + 
-                ", SumL=" + formatFloat(sum_left, 6) + 
-                ", SumR=" + formatFloat(sum_right, 6) + 
+        if (++level_state_.debug.mapping % 300 == 0) {            LOG_INFO("[RMS_DEBUG_MAPPING] Channels=" + std::to_string(numChannels) + 
+                ", CountL=" + std::to_string(groups.count[GroupLeft]) + 
+                ", CountR=" + std::to_string(groups.count[GroupRight]) + 
+                ", SumL=" + formatFloat(groups.sum[GroupLeft], 6) + 
+                ", SumR=" + formatFloat(groups.sum[GroupRight], 6) + 
                 ", RMSL=" + formatFloat(rms_left, 6) + 
                 ", RMSR=" + formatFloat(rms_right, 6));
         }
     }
     
-    float rms_center = count_center ? std::sqrt(sum_center / count_center) : 0.0f;
-    float rms_side_left = count_side_left ? std::sqrt(sum_side_left / count_side_left) : 0.0f;
-    float rms_side_right = count_side_right ? std::sqrt(sum_side_right / count_side_right) : 0.0f;
-    float rms_rear_left = count_rear_left ? std::sqrt(sum_rear_left / count_rear_left) : 0.0f;
-    float rms_rear_right = count_rear_right ? std::sqrt(sum_rear_right / count_rear_right) : 0.0f;
+    const float rms_center = groups.rms[GroupCenter];
+    const float rms_side_left = groups.rms[GroupSideLeft];
+    const float rms_side_right = groups.rms[GroupSideRight];
+    const float rms_rear_left = groups.rms[GroupRearLeft];
+    const float rms_rear_right = groups.rms[GroupRearRight];
     // --- Calculate pan value in [-1, +1] for uniform ---
     float pan_norm = 0.0f;
 
@@ -456,13 +145,12 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
 
         // DEBUG: Enhanced pan calculation debugging
         if (l + r > 0.001f) {  // Only log when there's significant audio
-            static int debug_counter = 0;
-            if (++debug_counter % 50 == 0) {  // Log every 50th frame for more frequent monitoring
+            if (++level_state_.debug.stereo % 50 == 0) {  // Log every 50th frame for more frequent monitoring
                 float sum = l + r;
                 float diff = r - l;
                 float abs_diff = std::abs(diff);
                 float rel_diff = abs_diff / sum;
-                LOG_INFO("[PAN_DEBUG_STEREO] Frame=" + std::to_string(debug_counter) +
+                LOG_INFO("[PAN_DEBUG_STEREO] Frame=" + std::to_string(level_state_.debug.stereo) +
                     ", L=" + formatFloat(l, 6) +
                     ", R=" + formatFloat(r, 6) +
                     ", Sum=" + formatFloat(sum, 6) +
@@ -488,8 +176,7 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
             float relative_diff = diff / sum;
 
             // DEBUG: Log decision logic path
-            static int decision_debug_counter = 0;
-            bool should_log_decision = (++decision_debug_counter % 50 == 0);
+            bool should_log_decision = (++level_state_.debug.decision % 50 == 0);
 
             // If the difference is within the deadzone, consider it balanced (centered)
             if (relative_diff < balance_deadzone) {
@@ -526,16 +213,14 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
                         " -> FinalPan=" + formatFloat(pan_norm, 6));
                 }
                 // DEBUG: Log calculated pan for diagnosis
-                static int pan_debug_counter = 0;
-                if (++pan_debug_counter % 100 == 0) {
+                if (++level_state_.debug.pan % 100 == 0) {
                     LOG_INFO("[PAN_DEBUG] Basic_Pan=" + formatFloat(basic_pan, 6) +
                         ", Final_Pan=" + formatFloat(pan_norm, 6));
                 }
             }
         } else {
             pan_norm = 0.0f;
-            static int silence_debug_counter = 0;
-            if (++silence_debug_counter % 200 == 0) {  // Log silence state occasionally
+            if (++level_state_.debug.silence % 200 == 0) {  // Log silence state occasionally
                 LOG_INFO("[PAN_DEBUG] SILENCE_STATE: L+R=" + formatFloat(l + r, 8) + " <= EnergyThresh=0.0001, Pan=0.0");
             }
         }
@@ -546,8 +231,7 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
         float total_energy = front_left_right_energy + other_channels_energy;
 
         // DEBUG: Log surround sound analysis
-        static int surround_debug_counter = 0;
-        if (++surround_debug_counter % 100 == 0) {
+        if (++level_state_.debug.surround % 100 == 0) {
             float stereo_ratio = (total_energy > 0.001f) ? (front_left_right_energy / total_energy) : 0.0f;
             LOG_INFO("[PAN_DEBUG_SURROUND] Channels=" + std::to_string(numChannels) +
                 ", FrontLR=" + formatFloat(front_left_right_energy, 6) +
@@ -564,8 +248,7 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
             float l = rms_left;
             float r = rms_right;
 
-            static int eff_stereo_debug_counter = 0;
-            if (++eff_stereo_debug_counter % 100 == 0) {
+            if (++level_state_.debug.effectively_stereo % 100 == 0) {
                 LOG_INFO("[PAN_DEBUG] EFFECTIVELY_STEREO: Using stereo calculation for " + std::to_string(numChannels) + "-ch audio");
             }
 
@@ -594,8 +277,7 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
             }
         } else {
             // True surround content - use vector sum with ITU-R BS.775 angles
-            static int true_surround_debug_counter = 0;
-            if (++true_surround_debug_counter % 100 == 0) {
+            if (++level_state_.debug.true_surround % 100 == 0) {
                 LOG_INFO("[PAN_DEBUG] TRUE_SURROUND: Using vector calculation for " + std::to_string(numChannels) +
                     "-ch audio. FL=" + formatFloat(rms_left, 4) +
                     ", FR=" + formatFloat(rms_right, 4) +
@@ -607,20 +289,11 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
             }
 
             // Angles (degrees): FL=-30, FR=+30, C=0, SL=-90, SR=+90, RL=-150, RR=+150
-            struct ChanAngle { float rms; float deg; } chans[7] = {
-                { rms_left, -30.0f },
-                { rms_right, +30.0f },
-                { rms_center, 0.0f },
-                { rms_side_left, -90.0f },
-                { rms_side_right, +90.0f },
-                { rms_rear_left, -150.0f },
-                { rms_rear_right, +150.0f }
-            };
+            // Unit vectors are precomputed in kSpeakerDirections (indexed by group)
             float x = 0.0f, y = 0.0f;
-            for (const auto& c : chans) {
-                float rad = c.deg * 3.14159265f / 180.0f;
-                x += c.rms * std::cos(rad);
-                y += c.rms * std::sin(rad);
+            for (int g = 0; g < GroupCount; g++) {
+                x += groups.rms[g] * kSpeakerDirections[g].cos;
+                y += groups.rms[g] * kSpeakerDirections[g].sin;
             }
             float pan_deg = 0.0f;
             if (x != 0.0f || y != 0.0f) {
@@ -629,8 +302,7 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
             pan_norm = std::clamp(pan_deg / 90.0f, -1.0f, 1.0f); // -1 to +1
 
             // DEBUG: Log vector calculation details
-            static int vector_debug_counter = 0;
-            if (++vector_debug_counter % 100 == 0) {
+            if (++level_state_.debug.vector % 100 == 0) {
                 LOG_INFO("[PAN_DEBUG_VECTOR] X=" + formatFloat(x, 6) +
                     ", Y=" + formatFloat(y, 6) +
                     ", PanDeg=" + formatFloat(pan_deg, 2) +
@@ -639,8 +311,7 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
         }
     } else {
         pan_norm = 0.0f;
-        static int unsupported_debug_counter = 0;
-        if (++unsupported_debug_counter % 200 == 0) {
+        if (++level_state_.debug.unsupported % 200 == 0) {
             LOG_INFO("[PAN_DEBUG] UNSUPPORTED_FORMAT: " + std::to_string(numChannels) + " channels, Pan=0.0");
         }
     }    // --- At this point, pan_norm is the detected pan value ---
@@ -652,44 +323,155 @@ void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels,
     }
     // Use pan_with_offset for smoothing/output
     
-    // Apply pan smoothing if enabled
-    static float smoothed_pan = 0.0f;
-    static bool pan_initialized = false;
+    // Smooth the packet's scalar outputs. dt is the packet duration, so the response no
+    // longer depends on the device's packet rate.
+    const float packet_dt = static_cast<float>(numFrames) / sample_rate_;
+    const OneEuroParams volume_params = SmoothingParams(config.smoothing.volumeMinCutoff, config.smoothing.volumeBeta, config);
+    out.volume = output_filters_.volume.Filter(out.volume, packet_dt, volume_params);
+    out.volume_left = output_filters_.volume_left.Filter(out.volume_left, packet_dt, volume_params);
+    out.volume_right = output_filters_.volume_right.Filter(out.volume_right, packet_dt, volume_params);
+    
+    const OneEuroParams pan_params = SmoothingParams(config.smoothing.panMinCutoff, config.smoothing.panBeta, config);
+    out.audio_pan = output_filters_.pan.Filter(pan_with_offset, packet_dt, pan_params);
+    if (++level_state_.debug.smoothing % 200 == 0) {
+        LOG_INFO("[PAN_SMOOTHING] MinCutoff=" + formatFloat(pan_params.min_cutoff, 3) + ", Beta=" + formatFloat(pan_params.beta, 3) +
+            ", Dt=" + formatFloat(packet_dt, 6) + ", Raw=" + formatFloat(pan_with_offset, 6) + ", Smoothed=" + formatFloat(out.audio_pan, 6));
+    }
+}
+
+// Spectrum, spectral flux and bands of one STFT frame (called by AnalyzeAudioBuffer with mutex_ held)
+void AudioAnalyzer::AnalyzeSpectrum(const float* frame, const Listeningway::Configuration& config, AudioAnalysisData& out) {
+    // Resize frequency bands vector if needed
+    if (out.freq_bands.size() != config.frequency.bands) {
+        out.freq_bands.resize(config.frequency.bands, 0.0f);
+        out.raw_freq_bands.resize(config.frequency.bands, 0.0f);
+    }
     
-    if (config.audio.panSmoothing > 0.0f) {
-        if (!pan_initialized) {
-            smoothed_pan = pan_with_offset;
-            pan_initialized = true;
-            LOG_INFO("[PAN_SMOOTHING] INITIALIZED: smoothed_pan=" + formatFloat(smoothed_pan, 6) + ", raw_pan=" + formatFloat(pan_with_offset, 6));
-        } else {
-            float alpha = 1.0f / (1.0f + config.audio.panSmoothing * 10.0f);
-            float prev_smoothed = smoothed_pan;
-            smoothed_pan = (1.0f - alpha) * smoothed_pan + alpha * pan_with_offset;
-            static int smoothing_debug_counter = 0;
-            if (++smoothing_debug_counter % 200 == 0) {
-                float smoothing_strength = config.audio.panSmoothing;
-                LOG_INFO("[PAN_SMOOTHING] Strength=" + formatFloat(smoothing_strength, 3) + ", Alpha=" + formatFloat(alpha, 6) + ", Raw=" + formatFloat(pan_with_offset, 6) + ", Prev=" + formatFloat(prev_smoothed, 6) + ", New=" + formatFloat(smoothed_pan, 6) + ", Delta=" + formatFloat(smoothed_pan - prev_smoothed, 6));
-            }
+    // Prepare FFT data
+    const size_t fft_size = config.frequency.fftSize;
+    const size_t half_fft_size = fft_size / 2;
+    
+    // Fetch the cached FFT plans; only rebuilt when the configured size changes.
+    // The mono downmix is purely real, so even sizes use the real-input transform
+    // (half the work); odd sizes fall back to the complex transform.
+    const bool use_real_fft = (fft_size % 2 == 0);
+    if (use_real_fft) {
+        if (!real_fft_plan_ || real_fft_plan_->Size() != fft_size) {
+            real_fft_plan_ = fft_plan_cache_.GetReal(fft_size, false);
+            caches_rebuilt_ = true;
         }
-        out.audio_pan = smoothed_pan;
+    } else if (!fft_plan_ || fft_plan_->Size() != fft_size) {
+        fft_plan_ = fft_plan_cache_.Get(fft_size, false);
+        caches_rebuilt_ = true;
+    }
+    if (use_real_fft ? !real_fft_plan_ : !fft_plan_) {
+        LOG_ERROR("[AudioAnalyzer] Failed to allocate FFT configuration");
+        return;
+    }
+    
+    // FFT buffers live in the preallocated workspace (sized by AnalyzeAudioBuffer)
+    auto& fft_in = workspace_.fft_in;
+    auto& fft_out = workspace_.fft_out;
+    auto& magnitudes = workspace_.magnitudes;
+    std::copy(frame, frame + fft_size, fft_in.begin());
+    
+    // The window table is precomputed per (type, size) and only re-fetched when either changes
+    const auto window_type = static_cast<FftWindowType>(config.frequency.windowType);
+    if (!window_ || window_->Type() != window_type || window_->Size() != fft_size) {
+        window_ = window_cache_.Get(window_type, fft_size);
+        caches_rebuilt_ = true;
+    }
+    
+    // Apply the analysis window as one flat multiply over the table
+    window_->Apply(fft_in.data(), fft_size);
+    
+    // Execute FFT
+    if (use_real_fft) {
+        // Real-to-complex: yields bins 0..N/2 directly, identical to the first half of the complex FFT
+        real_fft_plan_->Execute(fft_in.data(), fft_out.data());
     } else {
-        out.audio_pan = pan_with_offset;
-        static int no_smoothing_debug_counter = 0;
-        if (++no_smoothing_debug_counter % 500 == 0) {
-            LOG_INFO("[PAN_SMOOTHING] DISABLED: Using raw pan value=" + formatFloat(pan_with_offset, 6));
+        auto& complex_in = workspace_.complex_in;
+        for (size_t i = 0; i < fft_size; i++) {
+            complex_in[i].r = fft_in[i];
+            complex_in[i].i = 0.0f;
         }
-        pan_initialized = false;
+        fft_plan_->Execute(complex_in.data(), fft_out.data());
     }
     
-    // Free FFT configuration
-    kiss_fft_free(fft_cfg);
+    const auto& kernels = SimdKernels::Get();
     
-    // If audio analysis is disabled, reset all values
-    if (!config.audio.analysisEnabled) {
-        out.volume = 0.0f;
-        std::fill(out.freq_bands.begin(), out.freq_bands.end(), 0.0f);
-        out.beat = 0.0f;
+    // Calculate magnitude of each FFT bin: |c| = sqrt(real² + imag²)
+    kernels.magnitudes(fft_out.data(), magnitudes.data(), half_fft_size);
+    
+    // Calculate spectral flux (difference from previous magnitudes)
+    float flux = 0.0f;
+    float flux_low = 0.0f;
+    const size_t low_freq_cutoff = half_fft_size / 4; // Bottom 25% of spectrum
+    
+    if (out._prev_magnitudes.size() == half_fft_size) {
+        // Only count positive differences (increases in energy); also calculate flux
+        // for low frequencies only (for bass detection)
+        kernels.positive_flux(magnitudes.data(), out._prev_magnitudes.data(), half_fft_size, low_freq_cutoff,
+                              &flux, &flux_low);
+        
+        // Store the flux values for beat detection
+        out._flux_avg = flux / half_fft_size;
+        out._flux_low_avg = flux_low / low_freq_cutoff;
+    }
+    else {
+        // Initialize previous magnitudes the first time (or after an fftSize change)
+        out._prev_magnitudes.assign(half_fft_size, 0.0f);
+        out._flux_avg = 0.0f;
+        out._flux_low_avg = 0.0f;
+    }
+    
+    // Keep current magnitudes for the next frame by swapping buffers instead of copying;
+    // from here on out._prev_magnitudes holds this frame's magnitudes
+    out._prev_magnitudes.swap(magnitudes);
+    
+    // Populate frequency bands using proper mapping according to settings
+    const size_t bands = config.frequency.bands;
+    const bool use_log_scale = config.frequency.logScaleEnabled;
+    
+    // The bin-to-band mapping only depends on the band layout, FFT size and sample rate.
+    // It is checked against this frame's snapshot every frame rather than only after a
+    // FrequencyMapping change flag: a snapshot can be published before its listeners set
+    // the flag, and a mapping built for another band count or FFT size would write past
+    // raw_freq_bands and read past the magnitudes. The check is a few compares.
+    BandMappingParams mapping_params;
+    mapping_params.bands = bands;
+    mapping_params.fft_size = fft_size;
+    mapping_params.sample_rate = sample_rate_;
+    mapping_params.min_freq = config.frequency.minFreq;
+    mapping_params.max_freq = config.frequency.maxFreq;
+    mapping_params.log_scale = use_log_scale;
+    if (!band_mapping_.Matches(mapping_params)) {
+        band_mapping_.Build(mapping_params);
+        caches_rebuilt_ = true;
+    }
+    
+    // Average each band's bins in a single flat pass over the magnitudes
+    band_mapping_.Reduce(out._prev_magnitudes.data(), out.raw_freq_bands.data());
+    
+    // Store the raw (unmodified) band values for beat detection
+    for (size_t band = 0; band < bands; band++) {
+        out.raw_freq_bands[band] = std::min(1.0f, out.raw_freq_bands[band] * config.frequency.bandNorm);
+    }
+    
+    // Equalizer and logStrength gains only change with their settings (or the band count),
+    // so they are cached per band and applied to the raw bands with a single multiply.
+    // Checked every frame for the same reason as the mapping.
+    BandGainParams gain_params;
+    gain_params.bands = bands;
+    gain_params.equalizer_bands = config.frequency.equalizerBands;
+    gain_params.equalizer_width = config.frequency.equalizerWidth;
+    gain_params.log_strength = config.frequency.logStrength;
+    gain_params.log_scale = use_log_scale;
+    if (!band_gain_curve_.Matches(gain_params)) {
+        band_gain_curve_.Build(gain_params);
+        caches_rebuilt_ = true;
     }
+    band_gain_curve_.Apply(out.raw_freq_bands.data(), out.freq_bands.data());
 }
 
 // Implementation of AudioAnalyzer
@@ -705,7 +487,10 @@ AudioAnalyzer::~AudioAnalyzer() {
 
 void AudioAnalyzer::SetBeatDetectionAlgorithm(int algorithm) {
     std::lock_guard<std::mutex> lock(mutex_);
-    
+    SwitchDetectorLocked(algorithm);
+}
+
+void AudioAnalyzer::SwitchDetectorLocked(int algorithm) {
     if (current_algorithm_ == algorithm && beat_detector_ != nullptr) {
         // No change needed
         return;
@@ -719,7 +504,7 @@ void AudioAnalyzer::SetBeatDetectionAlgorithm(int algorithm) {
     
     // Create new detector
     LOG_DEBUG("[AudioAnalyzer] Creating new beat detector with algorithm: " + std::to_string(algorithm));
-    beat_detector_ = IBeatDetector::Create(algorithm);
+    beat_detector_ = IBeatDetector::Create(algorithm, worker_pool_);
     current_algorithm_ = algorithm;
     
     // Start new detector if analyzer is running
@@ -734,45 +519,75 @@ int AudioAnalyzer::GetBeatDetectionAlgorithm() const {
     return current_algorithm_;
 }
 
-void AudioAnalyzer::Start() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (is_running_) {
-        LOG_DEBUG("[AudioAnalyzer] Already running, ignoring Start() call");
-        return;
+void AudioAnalyzer::SetStreamSampleRate(float sample_rate) {
+    const float previous = stream_sample_rate_.exchange(sample_rate, std::memory_order_relaxed);
+    if (previous != sample_rate) {
+        // The band mapping is checked against the rate on every frame, so nothing to flag here
+        LOG_DEBUG("[AudioAnalyzer] Stream sample rate: " + std::to_string(sample_rate));
     }
-    
-    // Create detector if needed
-    if (!beat_detector_) {
-        LOG_DEBUG("[AudioAnalyzer] Creating default beat detector");
-        beat_detector_ = IBeatDetector::Create(current_algorithm_);
-    }
-    
-    // Start the detector
-    if (beat_detector_) {
-        LOG_DEBUG("[AudioAnalyzer] Starting beat detector");
-        beat_detector_->Start();
+}
+
+void AudioAnalyzer::OnConfigurationChanged(Listeningway::ConfigSectionMask changed,
+                                           const Listeningway::ConfigSnapshot& /*config*/) {
+    // Only record the change: the analysis thread picks up the snapshot itself, and doing
+    // the work there keeps the render thread from waiting on mutex_
+    dirty_sections_.fetch_or(changed, std::memory_order_release);
+}
+
+void AudioAnalyzer::Start() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        if (is_running_) {
+            LOG_DEBUG("[AudioAnalyzer] Already running, ignoring Start() call");
+            return;
+        }
+        
+        // Changes made while stopped were not observed, so revalidate everything
+        dirty_sections_.store(Listeningway::SectionBit(Listeningway::ConfigSection::All), std::memory_order_release);
+        
+        // Tempo analysis jobs run here; the pool lives as long as the analyzer runs, so
+        // switching detectors does not create or join threads
+        worker_pool_.Start();
+        
+        // Create detector if needed
+        if (!beat_detector_) {
+            LOG_DEBUG("[AudioAnalyzer] Creating default beat detector");
+            beat_detector_ = IBeatDetector::Create(current_algorithm_, worker_pool_);
+        }
+        
+        // Start the detector
+        if (beat_detector_) {
+            LOG_DEBUG("[AudioAnalyzer] Starting beat detector");
+            beat_detector_->Start();
+        }
+        
+        is_running_ = true;
     }
-    
-    is_running_ = true;
+    // Outside mutex_: notifications are delivered with the listener lock held
+    Listeningway::ConfigurationManager::Instance().AddChangeListener(this);
     LOG_DEBUG("[AudioAnalyzer] Started");
 }
 
 void AudioAnalyzer::Stop() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!is_running_) {
-        LOG_DEBUG("[AudioAnalyzer] Already stopped, ignoring Stop() call");
-        return;
-    }
-    
-    // Stop the detector
-    if (beat_detector_) {
-        LOG_DEBUG("[AudioAnalyzer] Stopping beat detector");
-        beat_detector_->Stop();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        if (!is_running_) {
+            LOG_DEBUG("[AudioAnalyzer] Already stopped, ignoring Stop() call");
+            return;
+        }
+        
+        // Stop the detector
+        if (beat_detector_) {
+            LOG_DEBUG("[AudioAnalyzer] Stopping beat detector");
+            beat_detector_->Stop();
+        }
+        worker_pool_.Stop();
+        
+        is_running_ = false;
     }
-    
-    is_running_ = false;
+    Listeningway::ConfigurationManager::Instance().RemoveChangeListener(this);
     LOG_DEBUG("[AudioAnalyzer] Stopped");
 }
 
@@ -782,18 +597,66 @@ void AudioAnalyzer::AnalyzeAudioBuffer(const float* data, size_t numFrames, size
         out.volume = 0.0f;
         std::fill(out.freq_bands.begin(), out.freq_bands.end(), 0.0f);
         out.beat = 0.0f;
+        PublishLocked(out);
         return;
     }
     
-    const auto config = Listeningway::ConfigurationManager::Snapshot(); // Thread-safe snapshot for audio analysis thread
-    // Call the standalone AnalyzeAudioBuffer function to perform the actual analysis
-    ::AnalyzeAudioBuffer(data, numFrames, numChannels, out);
+    // Take the change flags before the snapshot so a change published in between is seen
+    // again on the next packet rather than lost. The flags only say which work may be
+    // needed; caches whose size must match the snapshot check it themselves, since the
+    // snapshot can already be newer than the flags.
+    pending_sections_ |= dirty_sections_.exchange(0, std::memory_order_acquire) &
+                         Listeningway::SectionBit(Listeningway::ConfigSection::BeatAlgorithm);
+    
+    // One published snapshot for the whole packet (lock-free, no copy)
+    const Listeningway::ConfigSnapshot config_snapshot = Listeningway::ConfigurationManager::Current();
+    const Listeningway::Configuration& config = *config_snapshot;
+    
+    // Timing and bin frequencies follow the stream's real rate; the configured sample_rate
+    // only applies until a capture stream has reported its mix format.
+    const float stream_rate = stream_sample_rate_.load(std::memory_order_relaxed);
+    sample_rate_ = stream_rate > 0.0f ? stream_rate : config.sample_rate;
+    
+    // Algorithm changes swap the detector; beat parameter changes need nothing here because
+    // detectors read them from the snapshot, so their tempo state is kept
+    if (Listeningway::HasSection(pending_sections_, Listeningway::ConfigSection::BeatAlgorithm)) {
+        SwitchDetectorLocked(config.beat.algorithm);
+        pending_sections_ &= ~Listeningway::SectionBit(Listeningway::ConfigSection::BeatAlgorithm);
+    }
     
-    // Update beat analysis
-    if (beat_detector_) {
-        // Feed the data to the beat detector - extract flux and other values from the analysis data
-        // Since the detector needs magnitudes, flux, and time, we need to compute these from our data
-        float dt = 1.0f / config.sample_rate * numFrames; // Time delta based on sample rate and frames
+    // Size the workspace and STFT ring; these only reallocate when fftSize/hopSize change
+    // or a packet larger than any before arrives
+    const size_t fft_size = config.frequency.fftSize;
+    bool reconfigured = workspace_.Configure(fft_size);
+    reconfigured |= workspace_.Reserve(numFrames);
+    reconfigured |= stft_.Configure(fft_size, config.frequency.hopSize);
+    caches_rebuilt_ = false;
+    const size_t allocations_before = AllocationCounter::ThreadAllocations();
+    
+    // One fused pass over the interleaved packet: mono downmix for the STFT stage plus
+    // total and per-channel energy for volume and spatialization
+    float* mono = workspace_.mono.data();
+    PacketEnergy energy;
+    AccumulatePacket(data, numFrames, numChannels, mono, energy);
+    
+    // Volume and spatialization cover the whole packet
+    AnalyzeLevels(data, numFrames, numChannels, energy, config, out);
+    
+    // Cut the stream into fftSize frames every hopSize samples. A packet may complete zero,
+    // one or several frames, so the analysis rate no longer depends on the device's packet size.
+    // Every spectral frame advances time by exactly one hop.
+    const float dt = static_cast<float>(stft_.Hop()) / sample_rate_;
+    
+    size_t offset = 0;
+    while (offset < numFrames) {
+        offset += stft_.Push(mono + offset, numFrames - offset);
+        if (!stft_.FrameReady()) {
+            break;
+        }
+        stft_.ReadFrame(workspace_.frame.data());
+        
+        // Perform the spectral analysis of this frame
+        AnalyzeSpectrum(workspace_.frame.data(), config, out);
         
         // Process this frame with the beat detector
         // Important: We use raw audio analysis data for beat detection rather than
@@ -803,11 +666,63 @@ void AudioAnalyzer::AnalyzeAudioBuffer(const float* data, size_t numFrames, size
         // Get beat information from the detector
         BeatDetectorResult result = beat_detector_->GetResult();
         
-        // Update the audio analysis data with the beat detection results
+        // Update the audio analysis data with the beat detection results. Tempo is smoothed
+        // per frame; the filter restarts whenever the detector loses the tempo.
         out.beat = result.beat;
-        out.tempo_bpm = result.tempo_bpm;
+        if (result.tempo_detected) {
+            out.tempo_bpm = output_filters_.tempo.Filter(result.tempo_bpm, dt,
+                SmoothingParams(config.smoothing.tempoMinCutoff, config.smoothing.tempoBeta, config));
+        } else {
+            output_filters_.tempo.Reset();
+            out.tempo_bpm = result.tempo_bpm;
+        }
         out.tempo_confidence = result.confidence;
         out.beat_phase = result.beat_phase;
+        out.time_to_next_beat = result.time_to_next_beat;
+        out.beat_period = result.tempo_detected && result.tempo_bpm > 0.0f ? 60.0f / result.tempo_bpm : 0.0f;
         out.tempo_detected = result.tempo_detected;
     }
+    
+    // If audio analysis is disabled, reset all values
+    if (!config.audio.analysisEnabled) {
+        out.volume = 0.0f;
+        std::fill(out.freq_bands.begin(), out.freq_bands.end(), 0.0f);
+    }
+    
+    // Hand the finished frame to the render thread; it never sees a half-analyzed frame
+    PublishLocked(out);
+    
+    // Allocation hook (LISTENINGWAY_COUNT_ALLOCATIONS builds): once buffers and caches are
+    // sized, a packet (beat detector and publish included) must not allocate. After a rebuild
+    // the frame slots still grow once each, so the next FRAME_SLOT_WARMUP packets are exempt.
+    // Debug logging builds strings, so it is excluded.
+    const size_t allocations = AllocationCounter::ThreadAllocations() - allocations_before;
+    if (reconfigured || caches_rebuilt_) {
+        allocation_warmup_packets_ = FRAME_SLOT_WARMUP;
+    } else if (allocation_warmup_packets_ > 0) {
+        allocation_warmup_packets_--;
+    } else if (allocations > 0 && !Listeningway::RuntimeFlags::DebugEnabled()) {
+        steady_state_allocations_ += allocations;
+        LOG_ERROR("[AudioAnalyzer] " + std::to_string(allocations) + " heap allocation(s) in steady-state analysis");
+    }
+}
+
+void AudioAnalyzer::PublishFrame(const AudioAnalysisData& frame) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PublishLocked(frame);
+}
+
+void AudioAnalyzer::CopyLatestFrame(AudioAnalysisData& out) {
+    std::lock_guard<std::mutex> lock(frame_read_mutex_);
+    out = frames_.Read();
+}
+
+void AudioAnalyzer::PublishLocked(const AudioAnalysisData& frame) {
+    // Copy-assignment reuses the slot's vector capacity, so this only allocates while the
+    // three slots grow to the current band/FFT sizes
+    AudioAnalysisData& slot = frames_.Write();
+    slot = frame;
+    slot.sequence = ++published_frames_;
+    slot.published_at = std::chrono::steady_clock::now();
+    frames_.Publish();
 }
\ No newline at end of file
@@ -1,10 +1,22 @@
 #pragma once
 #include <vector>
 #include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include "constants.h"
 #include "beat_detector.h"
+#include "fft_plan_cache.h"
+#include "band_mapping.h"
+#include "band_gain_curve.h"
+#include "one_euro_filter.h"
+#include "window_table.h"
+#include "stft_framer.h"
+#include "analysis_workspace.h"
+#include "packet_kernel.h"
+#include "threading.h"
 #include "../../configuration/configuration_manager.h"
 
 // Audio analysis results for one frame
@@ -18,6 +30,8 @@ struct AudioAnalysisData {
     float tempo_bpm = 0.0f;            // Detected tempo in BPM
     float tempo_confidence = 0.0f;     // Confidence in tempo estimate [0,1]
     float beat_phase = 0.0f;           // Current phase in beat cycle [0,1]
+    float time_to_next_beat = 0.0f;    // Predicted seconds until the next beat (0 without a tempo)
+    float beat_period = 0.0f;          // Seconds per beat that beat_phase advances with (0 without a tempo)
     bool tempo_detected = false;       // Whether tempo has been detected
 
     // Internal analysis state (not for API consumers)
@@ -30,14 +44,22 @@ struct AudioAnalysisData {
     float volume_right = 0.0f;        // Right channel volume
     float audio_pan = 0.0f;           // Pan value [-1, +1]
     float audio_format = 0.0f;        // Audio format (0=none, 1=mono, 2=stereo, 6=5.1, 8=7.1)
+    uint64_t sequence = 0;            // Set on publish; increases with every published frame
+    std::chrono::steady_clock::time_point published_at{}; // Set on publish; beat_phase is current as of this time
 
     AudioAnalysisData(size_t bands = 8) : freq_bands(bands, 0.0f), raw_freq_bands(bands, 0.0f) {}
 };
 
 /**
  * @brief Analyzer for audio data, using beat detection algorithms
+ *
+ * Caches are only rebuilt for the settings they depend on: frequency mapping edits rebuild
+ * the band mapping, equalizer edits only the gain curve, and beat parameter edits nothing
+ * at all (detectors read them from the current snapshot), so tempo tracking survives slider
+ * drags. The band caches compare their parameters with each frame's snapshot; only the
+ * detector swap waits for the BeatAlgorithm change notification.
  */
-class AudioAnalyzer {
+class AudioAnalyzer : public IConfigurationChangeListener {
 public:
     /**
      * @brief Constructor
@@ -47,11 +69,11 @@ public:
     /**
      * @brief Destructor
      */
-    ~AudioAnalyzer();
+    ~AudioAnalyzer() override;
     
     /**
      * @brief Set the beat detection algorithm to use
-     * @param algorithm Algorithm index (0=SimpleEnergy, 1=SpectralFluxAuto)
+     * @param algorithm Algorithm index (0=SimpleEnergy, 1=SpectralFluxAuto, 2=PhaseLocked)
      */
     void SetBeatDetectionAlgorithm(int algorithm);
     
@@ -80,8 +102,129 @@ public:
      */
     void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels, AudioAnalysisData& out);
 
+    /**
+     * @brief Set the sample rate of the captured stream (from the device mix format)
+     * @param sample_rate Frames per second; 0 falls back to the configured sample_rate
+     */
+    void SetStreamSampleRate(float sample_rate);
+
+    /**
+     * @brief Publish a complete frame to the render thread without running analysis
+     * (e.g. zeros from the "off" provider). AnalyzeAudioBuffer publishes on its own.
+     * @param frame Writer-private analysis data to copy into the next published frame.
+     */
+    void PublishFrame(const AudioAnalysisData& frame);
+
+    /**
+     * @brief Copy the latest complete analysis frame (any thread). Never blocks on the
+     * analysis thread; concurrent readers (runtimes presenting on different threads, the
+     * overlay) are serialized by a reader-side mutex, since the triple buffer has a single
+     * reader slot that must not be handed back while another reader is still copying it.
+     * @param out Receives the frame; copy-assignment reuses its vector capacity.
+     */
+    void CopyLatestFrame(AudioAnalysisData& out);
+
+    /**
+     * @brief FFT plan cache of the spectrum analysis (real plans may only run on the analysis thread)
+     * @return The analyzer-owned plan cache
+     */
+    FftPlanCache& GetFftPlanCache() { return fft_plan_cache_; }
+
+    /**
+     * @brief Record which configuration sections changed; the analysis thread acts on them
+     * before its next packet
+     */
+    void OnConfigurationChanged(Listeningway::ConfigSectionMask changed,
+                                const Listeningway::ConfigSnapshot& config) override;
+
+    /**
+     * @brief Heap allocations observed in steady-state analysis (allocation-counting builds only)
+     * @return Total count; expected to stay zero
+     */
+    size_t GetSteadyStateAllocationCount() const { return steady_state_allocations_; }
+
 private:
+    /**
+     * @brief State AnalyzeLevels carries from one packet to the next. Kept per analyzer so
+     * several analyzers can run on separate threads without sharing anything mutable.
+     */
+    struct LevelState {
+        // Packet counters that rate-limit the periodic diagnostic log lines
+        struct DebugCounters {
+            int input = 0;
+            int numerical = 0;
+            int rms = 0;
+            int mapping = 0;
+            int stereo = 0;
+            int decision = 0;
+            int pan = 0;
+            int silence = 0;
+            int surround = 0;
+            int effectively_stereo = 0;
+            int true_surround = 0;
+            int vector = 0;
+            int unsupported = 0;
+            int smoothing = 0;
+        } debug;
+    };
+
+    /**
+     * @brief Output smoothing, one filter per scalar signal (configured by config.smoothing)
+     */
+    struct OutputFilters {
+        OneEuroFilter volume;
+        OneEuroFilter volume_left;
+        OneEuroFilter volume_right;
+        OneEuroFilter pan;
+        OneEuroFilter tempo;
+    };
+
+    /**
+     * @brief Compute volume, left/right levels and pan for one captured packet
+     */
+    void AnalyzeLevels(const float* data, size_t numFrames, size_t numChannels, const PacketEnergy& energy,
+                       const Listeningway::Configuration& config, AudioAnalysisData& out);
+
+    /**
+     * @brief Compute spectrum, spectral flux and bands for one STFT frame
+     * @param frame frequency.fftSize mono samples, oldest first
+     */
+    void AnalyzeSpectrum(const float* frame, const Listeningway::Configuration& config, AudioAnalysisData& out);
+
+    /**
+     * @brief Copy a frame into the triple buffer and publish it (mutex_ held)
+     */
+    void PublishLocked(const AudioAnalysisData& frame);
+
+    /**
+     * @brief Replace the beat detector (mutex_ held)
+     */
+    void SwitchDetectorLocked(int algorithm);
+
     mutable std::mutex mutex_;
+    FftPlanCache fft_plan_cache_;
+    WorkerPool worker_pool_;                           // Background jobs of the beat detectors (tempo analysis)
+    std::shared_ptr<const FftPlan> fft_plan_;          // Complex plan for odd frequency.fftSize values
+    std::shared_ptr<const RealFftPlan> real_fft_plan_; // Real-input plan for the current frequency.fftSize
+    WindowTableCache window_cache_;
+    std::shared_ptr<const WindowTable> window_;        // Analysis window for the current type and fftSize
+    BandMapping band_mapping_;                         // FFT bin to band assignment for the current layout
+    BandGainCurve band_gain_curve_;                    // Per-band equalizer/logStrength gain
+    StftFramer stft_;                                  // Streaming fftSize/hopSize framing of the mono downmix
+    AnalysisWorkspace workspace_;                      // Preallocated scratch buffers for the analysis path
+    LevelState level_state_;                           // Log rate limiting between packets
+    OutputFilters output_filters_;                     // Smoothing state of volume, pan and tempo
+    bool caches_rebuilt_ = false;                      // Set when a plan/window/mapping was rebuilt this packet
+    std::atomic<Listeningway::ConfigSectionMask> dirty_sections_{
+        Listeningway::SectionBit(Listeningway::ConfigSection::All) };  // Set by the listener, taken per packet
+    Listeningway::ConfigSectionMask pending_sections_ = 0;  // Change flags still to act on (analysis thread)
+    size_t steady_state_allocations_ = 0;
+    size_t allocation_warmup_packets_ = 0;             // Packets left before allocations count again
+    TripleBuffer<AudioAnalysisData> frames_;           // Frames published to the render thread
+    std::mutex frame_read_mutex_;                      // Serializes frames_ readers (never taken by the writer)
+    uint64_t published_frames_ = 0;                    // Sequence number of the last published frame
+    std::atomic<float> stream_sample_rate_{ 0.0f };    // Device mix format rate; 0 until a stream starts
+    float sample_rate_ = 0.0f;                         // Rate used for the current packet (analysis thread)
     std::unique_ptr<IBeatDetector> beat_detector_;
     int current_algorithm_ = 0;
     bool is_running_ = false;
@@ -89,6 +232,3 @@ private:
 
 // Global instance of the audio analyzer (accessible to all modules)
 extern AudioAnalyzer g_audio_analyzer;
-
-// Standalone function to analyze audio buffers using the static config
-void AnalyzeAudioBuffer(const float* data, size_t numFrames, size_t numChannels, AudioAnalysisData& out);
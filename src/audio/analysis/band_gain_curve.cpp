@@ -0,0 +1,56 @@
+// ---------------------------------------------
+// Band Gain Curve Implementation
+// ---------------------------------------------
+#include "band_gain_curve.h"
+#include "simd_kernels.h"
+#include "logging.h"
+#include <cmath>
+#include <string>
+
+void BandGainCurve::Build(const BandGainParams& params) {
+    params_ = params;
+    built_ = true;
+
+    const size_t bands = params.bands;
+    gains_.assign(bands, 1.0f);
+
+    // Bell curve centers for 5 bands (evenly distributed)
+    const float centers[5] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
+
+    // Width of the bell curve from user settings (smaller = sharper peaks, larger = more overlap)
+    const float bell_width = params.equalizer_width;
+
+    for (size_t band = 0; band < bands; band++) {
+        // Map band to normalized position from 0.0 to 1.0 across the frequency range
+        float normalized_pos = static_cast<float>(band) / (bands - 1);
+
+        // Apply bell curves from all 5 modifiers with position-based weighting
+        float total_weight = 0.0f;
+        float weighted_modifier = 0.0f;
+        for (int i = 0; i < 5; i++) {
+            // Calculate Gaussian weight: e^(-(x^2)/(2*sigma^2))
+            float distance = normalized_pos - centers[i];
+            float bell_value = std::exp(-(distance * distance) / (2.0f * bell_width * bell_width));
+            weighted_modifier += bell_value * params.equalizer_bands[i];
+            total_weight += bell_value;
+        }
+
+        // Normalize the weighted modifier if we have any weight
+        float gain = 1.0f;
+        if (total_weight > 0.0f) {
+            gain = weighted_modifier / total_weight;
+        }
+
+        // Apply logStrength as a logarithmic gain curve (only if log scale is enabled)
+        if (params.log_scale && params.log_strength != 0.0f) {
+            gain *= std::exp(static_cast<float>(band + 1) * (params.log_strength / 3));
+        }
+        gains_[band] = gain;
+    }
+
+    LOG_DEBUG("[BandGainCurve] Rebuilt gain curve for " + std::to_string(bands) + " bands");
+}
+
+void BandGainCurve::Apply(const float* raw_bands, float* out_bands) const {
+    SimdKernels::Get().multiply(raw_bands, gains_.data(), out_bands, gains_.size());
+}
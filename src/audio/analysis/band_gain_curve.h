@@ -0,0 +1,58 @@
+// ---------------------------------------------
+// Band Gain Curve
+// Precomputed per-band equalizer and log-strength gain
+// ---------------------------------------------
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Parameters that determine the per-band visualization gain.
+ */
+struct BandGainParams {
+    size_t bands = 0;
+    std::array<float, 5> equalizer_bands = {};
+    float equalizer_width = 0.0f;
+    float log_strength = 0.0f;
+    bool log_scale = false;
+
+    bool operator==(const BandGainParams& other) const {
+        return bands == other.bands && equalizer_bands == other.equalizer_bands &&
+               equalizer_width == other.equalizer_width && log_strength == other.log_strength &&
+               log_scale == other.log_scale;
+    }
+    bool operator!=(const BandGainParams& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Cached gain per band: 5-band bell-curve equalizer times the logStrength curve.
+ *
+ * Rebuilt only when the equalizer or log settings change, so the per-frame work is a
+ * single element-wise multiply of the raw bands by Gains().
+ */
+class BandGainCurve {
+public:
+    /**
+     * @brief Recompute the gain vector
+     * @param params Equalizer and log-strength settings
+     */
+    void Build(const BandGainParams& params);
+
+    /// True if the curve was built for exactly these parameters.
+    bool Matches(const BandGainParams& params) const { return built_ && params_ == params; }
+
+    /**
+     * @brief out[b] = raw[b] * gain[b] for every band
+     * @param raw_bands Raw band values
+     * @param out_bands Output (may not alias raw_bands)
+     */
+    void Apply(const float* raw_bands, float* out_bands) const;
+
+    const std::vector<float>& Gains() const { return gains_; }
+
+private:
+    BandGainParams params_;
+    bool built_ = false;
+    std::vector<float> gains_;
+};
@@ -0,0 +1,108 @@
+// ---------------------------------------------
+// Band Mapping Implementation
+// ---------------------------------------------
+#include "band_mapping.h"
+#include "simd_kernels.h"
+#include "logging.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+void BandMapping::Build(const BandMappingParams& params) {
+    params_ = params;
+    built_ = true;
+
+    const size_t bands = params.bands;
+    const size_t half_fft_size = params.fft_size / 2;
+    const float nyquist_freq = params.sample_rate * 0.5f;
+
+    band_edges_.assign(bands + 1, 0.0f);
+    first_bins_.assign(bands, 0);
+    bin_counts_.assign(bands, 0);
+    inv_counts_.assign(bands, 0.0f);
+    if (bands == 0 || half_fft_size < 2) {
+        return;
+    }
+
+    // Ensure min and max are within sensible ranges for the FFT size
+    const float effective_min_freq = std::max(20.0f, std::min(params.min_freq, nyquist_freq * 0.5f));
+    const float effective_max_freq = std::min(nyquist_freq, std::max(params.max_freq, effective_min_freq * 2.0f));
+
+    // Calculate band boundaries that ensure every FFT bin contributes to at least one band
+    if (params.log_scale) {
+        // Always use equal log steps for band edges
+        const float log_min = std::log10(effective_min_freq);
+        const float log_max = std::log10(effective_max_freq);
+        const float log_range = log_max - log_min;
+        for (size_t i = 0; i <= bands; i++) {
+            float t = static_cast<float>(i) / bands;
+            band_edges_[i] = std::pow(10.0f, log_min + t * log_range);
+        }
+    } else {
+        // Linear frequency distribution - equally spaced bands
+        for (size_t i = 0; i <= bands; i++) {
+            band_edges_[i] = effective_min_freq +
+                (effective_max_freq - effective_min_freq) * static_cast<float>(i) / bands;
+        }
+    }
+
+    // Ensure band edges are monotonically increasing and within valid range
+    for (size_t i = 0; i <= bands; i++) {
+        band_edges_[i] = std::max(effective_min_freq, std::min(effective_max_freq, band_edges_[i]));
+        if (i > 0) {
+            band_edges_[i] = std::max(band_edges_[i], band_edges_[i - 1] + 1.0f);
+        }
+    }
+
+    auto bin_freq = [&](size_t i) {
+        return static_cast<float>(i) * nyquist_freq / half_fft_size;
+    };
+
+    // Bins are visited in ascending frequency and edges are monotonic, so each band's
+    // bins form one contiguous run.
+    size_t bin = 1;
+    size_t total_bins = 0;
+    for (size_t b = 0; b < bands; b++) {
+        while (bin < half_fft_size && bin_freq(bin) < band_edges_[b]) {
+            bin++;
+        }
+        size_t first = bin;
+        while (bin < half_fft_size && bin_freq(bin) < band_edges_[b + 1]) {
+            bin++;
+        }
+        first_bins_[b] = first;
+        bin_counts_[b] = bin - first;
+
+        // Ensure every band has at least one bin (fix gaps) - use the bin closest to the band center
+        if (bin == first) {
+            float band_center = (band_edges_[b] + band_edges_[b + 1]) * 0.5f;
+            size_t closest_bin = 1;
+            float min_distance = std::numeric_limits<float>::max();
+            for (size_t i = 1; i < half_fft_size; i++) {
+                float distance = std::abs(bin_freq(i) - band_center);
+                if (distance < min_distance) {
+                    min_distance = distance;
+                    closest_bin = i;
+                }
+            }
+            first_bins_[b] = closest_bin;
+            bin_counts_[b] = 1;
+        }
+        inv_counts_[b] = 1.0f / static_cast<float>(bin_counts_[b]);
+        total_bins += bin_counts_[b];
+    }
+
+    LOG_DEBUG("[BandMapping] Rebuilt: bands=" + std::to_string(bands) +
+              ", fftSize=" + std::to_string(params.fft_size) +
+              ", entries=" + std::to_string(total_bins));
+}
+
+void BandMapping::Reduce(const float* magnitudes, float* out_bands) const {
+    const auto& kernels = SimdKernels::Get();
+    const size_t bands = params_.bands;
+    for (size_t b = 0; b < bands; b++) {
+        const float energy_sum = kernels.sum(magnitudes + first_bins_[b], bin_counts_[b]);
+        out_bands[b] = energy_sum * inv_counts_[b];
+    }
+}
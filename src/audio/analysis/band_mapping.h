@@ -0,0 +1,70 @@
+// ---------------------------------------------
+// Band Mapping
+// Precomputed FFT-bin to frequency-band assignment
+// ---------------------------------------------
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Parameters that determine the bin-to-band assignment.
+ *
+ * The mapping only has to be rebuilt when one of these changes.
+ */
+struct BandMappingParams {
+    size_t bands = 0;
+    size_t fft_size = 0;
+    float sample_rate = 0.0f;
+    float min_freq = 0.0f;
+    float max_freq = 0.0f;
+    bool log_scale = false;
+
+    bool operator==(const BandMappingParams& other) const {
+        return bands == other.bands && fft_size == other.fft_size &&
+               sample_rate == other.sample_rate && min_freq == other.min_freq &&
+               max_freq == other.max_freq && log_scale == other.log_scale;
+    }
+    bool operator!=(const BandMappingParams& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Compact mapping of FFT bins to frequency bands.
+ *
+ * Bins are assigned in ascending frequency against monotonic edges, so every band
+ * owns one contiguous run of bins: band b averages magnitudes
+ * [first_bins_[b], first_bins_[b] + bin_counts_[b]). Every band owns at least one
+ * bin: empty bands are assigned the bin nearest to their center so the
+ * visualization has no gaps.
+ */
+class BandMapping {
+public:
+    /**
+     * @brief Rebuild the mapping for new parameters
+     * @param params Band layout, FFT size and sample rate
+     */
+    void Build(const BandMappingParams& params);
+
+    /// True if the mapping was built for exactly these parameters.
+    bool Matches(const BandMappingParams& params) const { return built_ && params_ == params; }
+
+    /**
+     * @brief Average the magnitudes of each band's bins
+     * @param magnitudes FFT magnitudes (fft_size / 2 entries)
+     * @param out_bands Output, one value per band
+     */
+    void Reduce(const float* magnitudes, float* out_bands) const;
+
+    size_t BandCount() const { return params_.bands; }
+    const BandMappingParams& Params() const { return params_; }
+
+    /// Band edge frequencies in Hz (BandCount() + 1 entries).
+    const std::vector<float>& Edges() const { return band_edges_; }
+
+private:
+    BandMappingParams params_;
+    bool built_ = false;
+    std::vector<float> band_edges_;
+    std::vector<size_t> first_bins_; // First FFT bin of each band
+    std::vector<size_t> bin_counts_; // Number of bins in each band (at least 1)
+    std::vector<float> inv_counts_;  // 1 / bin_counts_
+};
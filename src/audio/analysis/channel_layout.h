@@ -0,0 +1,140 @@
+// ---------------------------------------------
+// Channel Layout
+// Compile-time channel-role tables and per-format channel grouping
+// ---------------------------------------------
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "constants.h"
+#include "audio_format_utils.h"
+#include "packet_kernel.h"
+
+namespace ChannelLayout {
+
+    // Speaker groups used for L/R volume and pan (ITU-R BS.775 order used by the vector pan)
+    enum ChannelGroup : int {
+        GroupLeft = 0,      // FL (+ SL on 5.1/7.1)
+        GroupRight,         // FR (+ SR, and RR on 7.1)
+        GroupCenter,        // C
+        GroupSideLeft,      // SL
+        GroupSideRight,     // SR
+        GroupRearLeft,      // RL
+        GroupRearRight,     // RR
+        GroupCount
+    };
+
+    /**
+     * @brief Group bit mask of one channel, derived from the AudioFormatUtils role predicates.
+     */
+    constexpr uint8_t GroupMask(AudioFormat format, int ch) {
+        uint8_t mask = 0;
+        if (AudioFormatUtils::IsLeftChannel(format, ch)) mask |= 1 << GroupLeft;
+        if (AudioFormatUtils::IsRightChannel(format, ch)) mask |= 1 << GroupRight;
+        if (AudioFormatUtils::IsCenterChannel(format, ch)) mask |= 1 << GroupCenter;
+        if (AudioFormatUtils::IsSideChannel(format, ch)) {
+            mask |= (ch == 4 || ch == 6) ? (1 << GroupSideLeft) : (1 << GroupSideRight);
+        }
+        if (AudioFormatUtils::IsRearChannel(format, ch)) {
+            mask |= (ch == 4) ? (1 << GroupRearLeft) : (1 << GroupRearRight);
+        }
+        return mask;
+    }
+
+    /**
+     * @brief Constexpr role table for one AudioFormat.
+     *
+     * Unknown layouts (AudioFormat::None) only use the first two channels as left/right,
+     * matching the AudioFormatUtils defaults.
+     */
+    template <AudioFormat F>
+    struct Layout {
+        static constexpr size_t kChannels = (F == AudioFormat::None) ? 2 : static_cast<size_t>(AudioFormatUtils::GetChannelCount(F));
+
+        static constexpr std::array<uint8_t, kChannels> MakeMasks() {
+            std::array<uint8_t, kChannels> masks = {};
+            for (size_t ch = 0; ch < kChannels; ch++) {
+                masks[ch] = GroupMask(F, static_cast<int>(ch));
+            }
+            return masks;
+        }
+
+        static constexpr std::array<size_t, GroupCount> MakeGroupSizes() {
+            std::array<size_t, GroupCount> sizes = {};
+            for (size_t ch = 0; ch < kChannels; ch++) {
+                for (int g = 0; g < GroupCount; g++) {
+                    if (MakeMasks()[ch] & (1 << g)) sizes[g]++;
+                }
+            }
+            return sizes;
+        }
+
+        static constexpr std::array<uint8_t, kChannels> kMasks = MakeMasks();
+        static constexpr std::array<size_t, GroupCount> kGroupSizes = MakeGroupSizes();
+    };
+
+    /**
+     * @brief Unit direction of a speaker position (angles in degrees, ITU-R BS.775)
+     */
+    struct SpeakerDirection {
+        float degrees;
+        float cos;
+        float sin;
+    };
+
+    // FL=-30, FR=+30, C=0, SL=-90, SR=+90, RL=-150, RR=+150, indexed by ChannelGroup
+    constexpr std::array<SpeakerDirection, GroupCount> kSpeakerDirections = {{
+        { -30.0f,  0.8660254f, -0.5f },
+        { +30.0f,  0.8660254f, +0.5f },
+        {   0.0f,  1.0f,        0.0f },
+        { -90.0f,  0.0f,       -1.0f },
+        { +90.0f,  0.0f,       +1.0f },
+        { -150.0f, -0.8660254f, -0.5f },
+        { +150.0f, -0.8660254f, +0.5f }
+    }};
+
+    /**
+     * @brief Per-group energy sums, sample counts and RMS for one packet
+     */
+    struct GroupLevels {
+        std::array<float, GroupCount> sum = {};
+        std::array<size_t, GroupCount> count = {};
+        std::array<float, GroupCount> rms = {};
+    };
+
+    /**
+     * @brief Fold per-channel energies into speaker groups for a fixed format (fully unrolled)
+     */
+    template <AudioFormat F>
+    GroupLevels GroupChannels(const PacketEnergy& energy, size_t numFrames) {
+        using L = Layout<F>;
+        GroupLevels levels;
+        for (size_t ch = 0; ch < L::kChannels; ch++) {
+            for (int g = 0; g < GroupCount; g++) {
+                if (L::kMasks[ch] & (1 << g)) {
+                    levels.sum[g] += energy.channel[ch];
+                }
+            }
+        }
+        for (int g = 0; g < GroupCount; g++) {
+            levels.count[g] = L::kGroupSizes[g] * numFrames;
+            levels.rms[g] = levels.count[g] ? std::sqrt(levels.sum[g] / levels.count[g]) : 0.0f;
+        }
+        return levels;
+    }
+
+    /**
+     * @brief Dispatch once per buffer to the specialization for the channel count
+     */
+    inline GroupLevels GroupChannels(size_t numChannels, const PacketEnergy& energy, size_t numFrames) {
+        switch (AudioFormatUtils::IntToFormat(static_cast<int>(numChannels))) {
+            case AudioFormat::Mono: return GroupChannels<AudioFormat::Mono>(energy, numFrames);
+            case AudioFormat::Stereo: return GroupChannels<AudioFormat::Stereo>(energy, numFrames);
+            case AudioFormat::Surround51: return GroupChannels<AudioFormat::Surround51>(energy, numFrames);
+            case AudioFormat::Surround71: return GroupChannels<AudioFormat::Surround71>(energy, numFrames);
+            default: return GroupChannels<AudioFormat::None>(energy, numFrames);
+        }
+    }
+
+} // namespace ChannelLayout
@@ -0,0 +1,90 @@
+// ---------------------------------------------
+// FFT Plan Cache Implementation
+// ---------------------------------------------
+#include "fft_plan_cache.h"
+#include "logging.h"
+#include <string>
+
+FftPlan::FftPlan(size_t size, bool inverse)
+    : cfg_(kiss_fft_alloc(static_cast<int>(size), inverse ? 1 : 0, nullptr, nullptr)),
+      size_(size),
+      inverse_(inverse) {
+}
+
+FftPlan::~FftPlan() {
+    if (cfg_) {
+        kiss_fft_free(cfg_);
+    }
+}
+
+void FftPlan::Execute(const kiss_fft_cpx* in, kiss_fft_cpx* out) const {
+    kiss_fft(cfg_, in, out);
+}
+
+RealFftPlan::RealFftPlan(size_t size, bool inverse)
+    : cfg_((size % 2 == 0) ? kiss_fftr_alloc(static_cast<int>(size), inverse ? 1 : 0, nullptr, nullptr) : nullptr),
+      size_(size),
+      inverse_(inverse) {
+}
+
+RealFftPlan::~RealFftPlan() {
+    if (cfg_) {
+        kiss_fft_free(cfg_);
+    }
+}
+
+void RealFftPlan::Execute(const kiss_fft_scalar* in, kiss_fft_cpx* out) const {
+    kiss_fftr(cfg_, in, out);
+}
+
+void RealFftPlan::Execute(const kiss_fft_cpx* in, kiss_fft_scalar* out) const {
+    kiss_fftri(cfg_, in, out);
+}
+
+std::shared_ptr<const FftPlan> FftPlanCache::Get(size_t size, bool inverse) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto key = std::make_pair(size, inverse);
+    auto it = plans_.find(key);
+    if (it != plans_.end()) {
+        return it->second;
+    }
+
+    auto plan = std::make_shared<const FftPlan>(size, inverse);
+    if (!plan->IsValid()) {
+        LOG_ERROR("[FftPlanCache] Failed to allocate FFT plan of size " + std::to_string(size));
+        return nullptr;
+    }
+
+    LOG_DEBUG("[FftPlanCache] Built FFT plan: size=" + std::to_string(size) +
+              (inverse ? ", inverse" : ", forward"));
+    plans_.emplace(key, plan);
+    return plan;
+}
+
+std::shared_ptr<const RealFftPlan> FftPlanCache::GetReal(size_t size, bool inverse) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto key = std::make_pair(size, inverse);
+    auto it = real_plans_.find(key);
+    if (it != real_plans_.end()) {
+        return it->second;
+    }
+
+    auto plan = std::make_shared<const RealFftPlan>(size, inverse);
+    if (!plan->IsValid()) {
+        LOG_ERROR("[FftPlanCache] Failed to allocate real FFT plan of size " + std::to_string(size));
+        return nullptr;
+    }
+
+    LOG_DEBUG("[FftPlanCache] Built real FFT plan: size=" + std::to_string(size) +
+              (inverse ? ", inverse" : ", forward"));
+    real_plans_.emplace(key, plan);
+    return plan;
+}
+
+void FftPlanCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    plans_.clear();
+    real_plans_.clear();
+}
@@ -0,0 +1,133 @@
+// ---------------------------------------------
+// FFT Plan Cache
+// Keeps kiss_fft configurations alive across analysis frames
+// ---------------------------------------------
+#pragma once
+#include <kiss_fft.h>
+#include <kiss_fftr.h>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+/**
+ * @brief Owns one kiss_fft configuration (twiddle table) for a fixed size and direction.
+ *
+ * kiss_fft only reads the configuration for out-of-place transforms, so a plan can be
+ * executed concurrently from several threads as long as input and output buffers are distinct.
+ */
+class FftPlan {
+public:
+    /**
+     * @brief Allocate a plan
+     * @param size Transform size (number of complex points)
+     * @param inverse True for an inverse transform
+     */
+    FftPlan(size_t size, bool inverse);
+    ~FftPlan();
+
+    FftPlan(const FftPlan&) = delete;
+    FftPlan& operator=(const FftPlan&) = delete;
+
+    /// True if kiss_fft allocated the configuration successfully.
+    bool IsValid() const { return cfg_ != nullptr; }
+    size_t Size() const { return size_; }
+    bool IsInverse() const { return inverse_; }
+
+    /**
+     * @brief Run the transform (out-of-place only)
+     * @param in Input buffer of Size() points
+     * @param out Output buffer of Size() points, must not alias in
+     */
+    void Execute(const kiss_fft_cpx* in, kiss_fft_cpx* out) const;
+
+private:
+    kiss_fft_cfg cfg_ = nullptr;
+    size_t size_ = 0;
+    bool inverse_ = false;
+};
+
+/**
+ * @brief Owns one kiss_fftr configuration for a real-input (or real-output) transform.
+ *
+ * A forward plan maps Size() real samples to Size()/2 + 1 complex bins; an inverse plan
+ * maps Size()/2 + 1 bins back to Size() real samples. kiss_fftr needs an even size.
+ *
+ * Not thread-safe: kiss_fftr keeps its scratch buffer inside the configuration, so a
+ * plan must only be executed by one thread at a time even though Execute() is const.
+ */
+class RealFftPlan {
+public:
+    /**
+     * @brief Allocate a plan
+     * @param size Transform size (number of real samples, must be even)
+     * @param inverse True for an inverse (complex-to-real) transform
+     */
+    RealFftPlan(size_t size, bool inverse);
+    ~RealFftPlan();
+
+    RealFftPlan(const RealFftPlan&) = delete;
+    RealFftPlan& operator=(const RealFftPlan&) = delete;
+
+    /// True if kiss_fftr allocated the configuration successfully.
+    bool IsValid() const { return cfg_ != nullptr; }
+    size_t Size() const { return size_; }
+    bool IsInverse() const { return inverse_; }
+
+    /**
+     * @brief Real-to-complex transform (forward plans only)
+     * @param in Size() real samples
+     * @param out Size()/2 + 1 complex bins
+     */
+    void Execute(const kiss_fft_scalar* in, kiss_fft_cpx* out) const;
+
+    /**
+     * @brief Complex-to-real transform (inverse plans only, unnormalized)
+     * @param in Size()/2 + 1 complex bins
+     * @param out Size() real samples
+     */
+    void Execute(const kiss_fft_cpx* in, kiss_fft_scalar* out) const;
+
+private:
+    kiss_fftr_cfg cfg_ = nullptr;
+    size_t size_ = 0;
+    bool inverse_ = false;
+};
+
+/**
+ * @brief Cache of FFT plans keyed by (size, inverse).
+ *
+ * Owned by AudioAnalyzer for the spectrum analysis. Plans are handed out as shared
+ * pointers so a consumer keeps its plan alive even if the cache is cleared. Every caller
+ * asking for the same key gets the same plan, so real plans (see RealFftPlan) may only be
+ * executed from one thread; other threads build their own RealFftPlan instead.
+ */
+class FftPlanCache {
+public:
+    /**
+     * @brief Get (or build on first use) the plan for a transform size and direction
+     * @param size Transform size
+     * @param inverse True for an inverse transform
+     * @return The plan, or nullptr if kiss_fft could not allocate it
+     */
+    std::shared_ptr<const FftPlan> Get(size_t size, bool inverse = false);
+
+    /**
+     * @brief Get (or build on first use) the real-input plan for a transform size and direction
+     * @param size Transform size (must be even)
+     * @param inverse True for an inverse (complex-to-real) transform
+     * @return The plan, or nullptr if the size is odd or kiss_fftr could not allocate it
+     */
+    std::shared_ptr<const RealFftPlan> GetReal(size_t size, bool inverse = false);
+
+    /**
+     * @brief Drop all cached plans (plans still held by consumers stay alive)
+     */
+    void Clear();
+
+private:
+    std::mutex mutex_;
+    std::map<std::pair<size_t, bool>, std::shared_ptr<const FftPlan>> plans_;
+    std::map<std::pair<size_t, bool>, std::shared_ptr<const RealFftPlan>> real_plans_;
+};
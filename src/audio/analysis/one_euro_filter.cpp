@@ -0,0 +1,42 @@
+// ---------------------------------------------
+// One-Euro Filter Implementation
+// ---------------------------------------------
+#include "one_euro_filter.h"
+#include <cmath>
+
+namespace {
+
+// Smoothing factor of a first-order low-pass with the given cutoff over dt. The exact
+// discretization (rather than the usual r / (r + 1) approximation) keeps the response
+// independent of the update rate, even for coarse packets.
+float SmoothingFactor(float cutoff, float dt) {
+    return 1.0f - std::exp(-2.0f * 3.14159265f * cutoff * dt);
+}
+
+} // namespace
+
+float OneEuroFilter::Filter(float value, float dt, const OneEuroParams& params) {
+    if (params.min_cutoff <= 0.0f) {
+        initialized_ = false;
+        return value;
+    }
+    if (!initialized_) {
+        value_ = value;
+        raw_value_ = value;
+        derivative_ = 0.0f;
+        initialized_ = true;
+        return value;
+    }
+    if (dt <= 0.0f) {
+        return value_;
+    }
+    
+    // Smooth the speed of the raw signal, then open the cutoff in proportion to it. Using the
+    // raw (not filtered) previous value keeps a step's contribution independent of dt.
+    const float speed = (value - raw_value_) / dt;
+    raw_value_ = value;
+    derivative_ += SmoothingFactor(params.derivative_cutoff, dt) * (speed - derivative_);
+    const float cutoff = params.min_cutoff + params.beta * std::abs(derivative_);
+    value_ += SmoothingFactor(cutoff, dt) * (value - value_);
+    return value_;
+}
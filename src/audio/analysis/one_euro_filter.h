@@ -0,0 +1,45 @@
+// ---------------------------------------------
+// One-Euro Filter
+// Speed-adaptive, frame-rate-independent low-pass filter for scalar outputs
+// ---------------------------------------------
+#pragma once
+
+/**
+ * @brief Parameters of one filtered signal.
+ */
+struct OneEuroParams {
+    float min_cutoff = 0.0f;        // Cutoff (Hz) while the signal is steady; <= 0 disables filtering
+    float beta = 0.0f;              // Cutoff increase per unit/s of signal speed
+    float derivative_cutoff = 1.0f; // Cutoff (Hz) of the speed estimate
+};
+
+/**
+ * @brief One-Euro low-pass filter (Casiez et al.).
+ *
+ * The smoothing factor is derived from the elapsed time of each update, so the response
+ * is the same whatever rate the filter is fed at. The cutoff rises with the estimated
+ * speed of the signal: a steady signal is smoothed hard (no jitter) while a fast move
+ * raises the cutoff and passes through with little lag.
+ */
+class OneEuroFilter {
+public:
+    /**
+     * @brief Filter one sample
+     * @param value New raw value
+     * @param dt Seconds since the previous sample
+     * @param params Cutoff settings (may change between calls)
+     * @return Filtered value; the raw value while disabled or on the first sample
+     */
+    float Filter(float value, float dt, const OneEuroParams& params);
+
+    /**
+     * @brief Forget the history; the next sample passes through unfiltered
+     */
+    void Reset() { initialized_ = false; }
+
+private:
+    float value_ = 0.0f;      // Filtered output
+    float raw_value_ = 0.0f;  // Previous input, for the speed estimate
+    float derivative_ = 0.0f; // Smoothed speed (units/s)
+    bool initialized_ = false;
+};
@@ -0,0 +1,70 @@
+// ---------------------------------------------
+// Packet Kernel Implementation
+// ---------------------------------------------
+#include "packet_kernel.h"
+#include "simd_kernels.h"
+
+namespace {
+    // Channel count known at compile time: the inner loop is fully unrolled and the
+    // per-channel sums stay in registers.
+    template <size_t N>
+    void AccumulateFixed(const float* data, size_t numFrames, float* mono, PacketEnergy& energy) {
+        float sums[N] = {};
+        for (size_t i = 0; i < numFrames; i++) {
+            const float* frame = data + i * N;
+            float sample = 0.0f;
+            for (size_t ch = 0; ch < N; ch++) {
+                const float x = frame[ch];
+                sample += x;
+                sums[ch] += x * x;
+            }
+            mono[i] = sample / static_cast<float>(N);
+        }
+        for (size_t ch = 0; ch < N; ch++) {
+            energy.channel[ch] = sums[ch];
+            energy.total += sums[ch];
+        }
+    }
+
+    void AccumulateGeneric(const float* data, size_t numFrames, size_t numChannels, float* mono, PacketEnergy& energy) {
+        const size_t tracked = numChannels < PACKET_KERNEL_MAX_CHANNELS ? numChannels : PACKET_KERNEL_MAX_CHANNELS;
+        float sums[PACKET_KERNEL_MAX_CHANNELS] = {};
+        float untracked = 0.0f;
+        for (size_t i = 0; i < numFrames; i++) {
+            const float* frame = data + i * numChannels;
+            float sample = 0.0f;
+            for (size_t ch = 0; ch < tracked; ch++) {
+                const float x = frame[ch];
+                sample += x;
+                sums[ch] += x * x;
+            }
+            for (size_t ch = tracked; ch < numChannels; ch++) {
+                const float x = frame[ch];
+                sample += x;
+                untracked += x * x;
+            }
+            mono[i] = sample / static_cast<float>(numChannels);
+        }
+        for (size_t ch = 0; ch < tracked; ch++) {
+            energy.channel[ch] = sums[ch];
+            energy.total += sums[ch];
+        }
+        energy.total += untracked;
+    }
+}
+
+void AccumulatePacket(const float* data, size_t numFrames, size_t numChannels, float* mono, PacketEnergy& energy) {
+    energy = PacketEnergy{};
+    switch (numChannels) {
+        case 0: break;
+        case 1: AccumulateFixed<1>(data, numFrames, mono, energy); break;
+        case 2:
+            // Most common layout: vectorized deinterleave (SSE2/AVX2/NEON)
+            SimdKernels::Get().accumulate_stereo(data, numFrames, mono, &energy.channel[0], &energy.channel[1]);
+            energy.total = energy.channel[0] + energy.channel[1];
+            break;
+        case 6: AccumulateFixed<6>(data, numFrames, mono, energy); break;
+        case 8: AccumulateFixed<8>(data, numFrames, mono, energy); break;
+        default: AccumulateGeneric(data, numFrames, numChannels, mono, energy); break;
+    }
+}
@@ -0,0 +1,32 @@
+// ---------------------------------------------
+// Packet Kernel
+// Fused single-pass downmix and energy accumulation over interleaved audio
+// ---------------------------------------------
+#pragma once
+#include <array>
+#include <cstddef>
+
+// Channels whose energy is tracked individually (7.1 is the widest supported layout)
+constexpr size_t PACKET_KERNEL_MAX_CHANNELS = 8;
+
+/**
+ * @brief Energy sums (sum of squares) gathered from one packet.
+ */
+struct PacketEnergy {
+    float total = 0.0f;                                     // All samples of all channels
+    std::array<float, PACKET_KERNEL_MAX_CHANNELS> channel = {}; // Per channel, first 8 channels
+};
+
+/**
+ * @brief Read every interleaved sample exactly once, producing the mono downmix and energies.
+ *
+ * Replaces the separate RMS, downmix and per-channel spatialization passes. Mono, stereo,
+ * 5.1 and 7.1 use fixed-channel-count specializations; other layouts use a generic loop.
+ *
+ * @param data Interleaved samples (numFrames * numChannels)
+ * @param numFrames Frames in the packet
+ * @param numChannels Channels per frame
+ * @param mono Output, numFrames averaged samples
+ * @param energy Output energy sums
+ */
+void AccumulatePacket(const float* data, size_t numFrames, size_t numChannels, float* mono, PacketEnergy& energy);
@@ -0,0 +1,91 @@
+// ---------------------------------------------
+// SIMD Kernels - Scalar Reference and Dispatch
+// ---------------------------------------------
+#include "simd_kernels.h"
+#include "logging.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace SimdKernels {
+
+namespace {
+    void MagnitudesScalar(const kiss_fft_cpx* bins, float* out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = std::sqrt(bins[i].r * bins[i].r + bins[i].i * bins[i].i);
+        }
+    }
+
+    void PositiveFluxScalar(const float* current, const float* previous, size_t count, size_t low_count,
+                            float* flux, float* flux_low) {
+        low_count = std::min(low_count, count);
+        float low = 0.0f;
+        for (size_t i = 0; i < low_count; i++) {
+            low += std::max(0.0f, current[i] - previous[i]);
+        }
+        float high = 0.0f;
+        for (size_t i = low_count; i < count; i++) {
+            high += std::max(0.0f, current[i] - previous[i]);
+        }
+        *flux_low = low;
+        *flux = low + high;
+    }
+
+    void MultiplyScalar(const float* a, const float* b, float* out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    float SumScalar(const float* data, size_t count) {
+        float total = 0.0f;
+        for (size_t i = 0; i < count; i++) {
+            total += data[i];
+        }
+        return total;
+    }
+
+    void AccumulateStereoScalar(const float* data, size_t frames, float* mono, float* energy_left, float* energy_right) {
+        float left_sum = 0.0f, right_sum = 0.0f;
+        for (size_t i = 0; i < frames; i++) {
+            const float l = data[2 * i];
+            const float r = data[2 * i + 1];
+            mono[i] = (l + r) / 2.0f;
+            left_sum += l * l;
+            right_sum += r * r;
+        }
+        *energy_left = left_sum;
+        *energy_right = right_sum;
+    }
+
+    const KernelTable kScalarTable = {
+        "Scalar",
+        MagnitudesScalar,
+        PositiveFluxScalar,
+        MultiplyScalar,
+        SumScalar,
+        AccumulateStereoScalar
+    };
+
+    const KernelTable& Select() {
+        for (const KernelTable* candidate : { Avx2(), Sse2(), Neon() }) {
+            if (candidate) {
+                LOG_DEBUG(std::string("[SimdKernels] Using ") + candidate->name + " kernels");
+                return *candidate;
+            }
+        }
+        LOG_DEBUG("[SimdKernels] Using scalar kernels");
+        return kScalarTable;
+    }
+}
+
+const KernelTable& Scalar() {
+    return kScalarTable;
+}
+
+const KernelTable& Get() {
+    static const KernelTable& selected = Select();
+    return selected;
+}
+
+} // namespace SimdKernels
@@ -0,0 +1,55 @@
+// ---------------------------------------------
+// SIMD Kernels
+// Vectorized inner loops of the analysis path with runtime CPU dispatch
+// ---------------------------------------------
+#pragma once
+#include <kiss_fft.h>
+#include <cstddef>
+
+namespace SimdKernels {
+
+    /**
+     * @brief One implementation of every vectorized analysis loop.
+     *
+     * All tables compute the same results as the scalar table up to floating-point
+     * reassociation in the reductions (sum, flux, energy).
+     */
+    struct KernelTable {
+        const char* name;
+
+        /// out[k] = sqrt(re² + im²) for count bins
+        void (*magnitudes)(const kiss_fft_cpx* bins, float* out, size_t count);
+
+        /// flux = Σ max(0, current - previous) over count bins; flux_low = the same over the first low_count bins
+        void (*positive_flux)(const float* current, const float* previous, size_t count, size_t low_count,
+                              float* flux, float* flux_low);
+
+        /// out[i] = a[i] * b[i] (out may alias a)
+        void (*multiply)(const float* a, const float* b, float* out, size_t count);
+
+        /// Σ data[i]
+        float (*sum)(const float* data, size_t count);
+
+        /// Interleaved stereo: mono[i] = (L + R) / 2, energy_left = Σ L², energy_right = Σ R²
+        void (*accumulate_stereo)(const float* data, size_t frames, float* mono, float* energy_left, float* energy_right);
+    };
+
+    /**
+     * @brief Best kernel table for this CPU (selected on first call)
+     *
+     * Candidates are AVX2 and SSE2 on x86/x64 and NEON on ARM64, falling back to the
+     * scalar table. tests/simd_kernels_test.cpp checks every table against the scalar one.
+     */
+    const KernelTable& Get();
+
+    /**
+     * @brief Portable scalar reference implementation
+     */
+    const KernelTable& Scalar();
+
+    // Architecture-specific tables (nullptr when not compiled for or not supported by this CPU)
+    const KernelTable* Sse2();
+    const KernelTable* Avx2();
+    const KernelTable* Neon();
+
+} // namespace SimdKernels
@@ -0,0 +1,120 @@
+// ---------------------------------------------
+// SIMD Kernels - NEON (ARM64)
+// ---------------------------------------------
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+#include <arm_neon.h>
+
+namespace SimdKernels {
+
+namespace {
+    void MagnitudesNeon(const kiss_fft_cpx* bins, float* out, size_t count) {
+        const float* in = reinterpret_cast<const float*>(bins);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float32x4x2_t v = vld2q_f32(in + 2 * i); // val[0] = re, val[1] = im
+            const float32x4_t power = vaddq_f32(vmulq_f32(v.val[0], v.val[0]), vmulq_f32(v.val[1], v.val[1]));
+            vst1q_f32(out + i, vsqrtq_f32(power));
+        }
+        for (; i < count; i++) {
+            out[i] = std::sqrt(bins[i].r * bins[i].r + bins[i].i * bins[i].i);
+        }
+    }
+
+    float PositiveFluxRangeNeon(const float* current, const float* previous, size_t begin, size_t end) {
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        float32x4_t acc = zero;
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            const float32x4_t diff = vsubq_f32(vld1q_f32(current + i), vld1q_f32(previous + i));
+            acc = vaddq_f32(acc, vmaxq_f32(diff, zero));
+        }
+        float total = vaddvq_f32(acc);
+        for (; i < end; i++) {
+            total += std::max(0.0f, current[i] - previous[i]);
+        }
+        return total;
+    }
+
+    void PositiveFluxNeon(const float* current, const float* previous, size_t count, size_t low_count,
+                          float* flux, float* flux_low) {
+        low_count = std::min(low_count, count);
+        const float low = PositiveFluxRangeNeon(current, previous, 0, low_count);
+        *flux_low = low;
+        *flux = low + PositiveFluxRangeNeon(current, previous, low_count, count);
+    }
+
+    void MultiplyNeon(const float* a, const float* b, float* out, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            vst1q_f32(out + i, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+        }
+        for (; i < count; i++) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    float SumNeon(const float* data, size_t count) {
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            acc = vaddq_f32(acc, vld1q_f32(data + i));
+        }
+        float total = vaddvq_f32(acc);
+        for (; i < count; i++) {
+            total += data[i];
+        }
+        return total;
+    }
+
+    void AccumulateStereoNeon(const float* data, size_t frames, float* mono, float* energy_left, float* energy_right) {
+        const float32x4_t half = vdupq_n_f32(0.5f);
+        float32x4_t acc_left = vdupq_n_f32(0.0f);
+        float32x4_t acc_right = vdupq_n_f32(0.0f);
+        size_t i = 0;
+        for (; i + 4 <= frames; i += 4) {
+            const float32x4x2_t v = vld2q_f32(data + 2 * i); // val[0] = L, val[1] = R
+            vst1q_f32(mono + i, vmulq_f32(vaddq_f32(v.val[0], v.val[1]), half));
+            acc_left = vaddq_f32(acc_left, vmulq_f32(v.val[0], v.val[0]));
+            acc_right = vaddq_f32(acc_right, vmulq_f32(v.val[1], v.val[1]));
+        }
+        float left_sum = vaddvq_f32(acc_left);
+        float right_sum = vaddvq_f32(acc_right);
+        for (; i < frames; i++) {
+            const float l = data[2 * i];
+            const float r = data[2 * i + 1];
+            mono[i] = (l + r) * 0.5f;
+            left_sum += l * l;
+            right_sum += r * r;
+        }
+        *energy_left = left_sum;
+        *energy_right = right_sum;
+    }
+
+    const KernelTable kNeonTable = {
+        "NEON",
+        MagnitudesNeon,
+        PositiveFluxNeon,
+        MultiplyNeon,
+        SumNeon,
+        AccumulateStereoNeon
+    };
+}
+
+const KernelTable* Neon() {
+    // NEON is mandatory on ARM64
+    return &kNeonTable;
+}
+
+} // namespace SimdKernels
+
+#else
+
+namespace SimdKernels {
+const KernelTable* Neon() { return nullptr; }
+} // namespace SimdKernels
+
+#endif
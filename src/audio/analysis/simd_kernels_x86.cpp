@@ -0,0 +1,271 @@
+// ---------------------------------------------
+// SIMD Kernels - SSE2 and AVX2 (x86/x64)
+// ---------------------------------------------
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LISTENINGWAY_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef LISTENINGWAY_SIMD_X86
+
+// MSVC allows AVX2 intrinsics in any function; GCC/Clang need a per-function target
+#if defined(_MSC_VER) && !defined(__clang__)
+#define LW_TARGET_AVX2
+#else
+#define LW_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace SimdKernels {
+
+namespace {
+    // ---- Shared scalar tails ----
+    inline float PositiveDiff(float a, float b) { return std::max(0.0f, a - b); }
+
+    // ---- SSE2 ----
+    inline float HorizontalSum(__m128 v) {
+        __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 sums = _mm_add_ps(v, shuf);
+        shuf = _mm_movehl_ps(shuf, sums);
+        sums = _mm_add_ss(sums, shuf);
+        return _mm_cvtss_f32(sums);
+    }
+
+    void MagnitudesSse2(const kiss_fft_cpx* bins, float* out, size_t count) {
+        const float* in = reinterpret_cast<const float*>(bins);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128 a = _mm_loadu_ps(in + 2 * i);       // r0 i0 r1 i1
+            const __m128 b = _mm_loadu_ps(in + 2 * i + 4);   // r2 i2 r3 i3
+            const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            _mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im))));
+        }
+        for (; i < count; i++) {
+            out[i] = std::sqrt(bins[i].r * bins[i].r + bins[i].i * bins[i].i);
+        }
+    }
+
+    float PositiveFluxRangeSse2(const float* current, const float* previous, size_t begin, size_t end) {
+        const __m128 zero = _mm_setzero_ps();
+        __m128 acc = zero;
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            const __m128 diff = _mm_sub_ps(_mm_loadu_ps(current + i), _mm_loadu_ps(previous + i));
+            acc = _mm_add_ps(acc, _mm_max_ps(diff, zero));
+        }
+        float total = HorizontalSum(acc);
+        for (; i < end; i++) {
+            total += PositiveDiff(current[i], previous[i]);
+        }
+        return total;
+    }
+
+    void PositiveFluxSse2(const float* current, const float* previous, size_t count, size_t low_count,
+                          float* flux, float* flux_low) {
+        low_count = std::min(low_count, count);
+        const float low = PositiveFluxRangeSse2(current, previous, 0, low_count);
+        *flux_low = low;
+        *flux = low + PositiveFluxRangeSse2(current, previous, low_count, count);
+    }
+
+    void MultiplySse2(const float* a, const float* b, float* out, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        }
+        for (; i < count; i++) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    float SumSse2(const float* data, size_t count) {
+        __m128 acc = _mm_setzero_ps();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            acc = _mm_add_ps(acc, _mm_loadu_ps(data + i));
+        }
+        float total = HorizontalSum(acc);
+        for (; i < count; i++) {
+            total += data[i];
+        }
+        return total;
+    }
+
+    void AccumulateStereoSse2(const float* data, size_t frames, float* mono, float* energy_left, float* energy_right) {
+        const __m128 half = _mm_set1_ps(0.5f);
+        __m128 acc_left = _mm_setzero_ps();
+        __m128 acc_right = _mm_setzero_ps();
+        size_t i = 0;
+        for (; i + 4 <= frames; i += 4) {
+            const __m128 a = _mm_loadu_ps(data + 2 * i);       // L0 R0 L1 R1
+            const __m128 b = _mm_loadu_ps(data + 2 * i + 4);   // L2 R2 L3 R3
+            const __m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            _mm_storeu_ps(mono + i, _mm_mul_ps(_mm_add_ps(l, r), half));
+            acc_left = _mm_add_ps(acc_left, _mm_mul_ps(l, l));
+            acc_right = _mm_add_ps(acc_right, _mm_mul_ps(r, r));
+        }
+        float left_sum = HorizontalSum(acc_left);
+        float right_sum = HorizontalSum(acc_right);
+        for (; i < frames; i++) {
+            const float l = data[2 * i];
+            const float r = data[2 * i + 1];
+            mono[i] = (l + r) * 0.5f;
+            left_sum += l * l;
+            right_sum += r * r;
+        }
+        *energy_left = left_sum;
+        *energy_right = right_sum;
+    }
+
+    const KernelTable kSse2Table = {
+        "SSE2",
+        MagnitudesSse2,
+        PositiveFluxSse2,
+        MultiplySse2,
+        SumSse2,
+        AccumulateStereoSse2
+    };
+
+    // ---- AVX2 ----
+    LW_TARGET_AVX2 inline float HorizontalSum256(__m256 v) {
+        const __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        return HorizontalSum(sum);
+    }
+
+    // Deinterleave 8 (even, odd) float pairs from two 256-bit loads into even and odd vectors.
+    // _mm256_shuffle_ps works per 128-bit lane, so the 64-bit blocks are put back in order afterwards.
+    LW_TARGET_AVX2 inline void Deinterleave256(__m256 a, __m256 b, __m256& even, __m256& odd) {
+        const __m256 e = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 o = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        even = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(e), _MM_SHUFFLE(3, 1, 2, 0)));
+        odd = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(o), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+
+    LW_TARGET_AVX2 void MagnitudesAvx2(const kiss_fft_cpx* bins, float* out, size_t count) {
+        const float* in = reinterpret_cast<const float*>(bins);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 re, im;
+            Deinterleave256(_mm256_loadu_ps(in + 2 * i), _mm256_loadu_ps(in + 2 * i + 8), re, im);
+            _mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(re, re), _mm256_mul_ps(im, im))));
+        }
+        MagnitudesSse2(bins + i, out + i, count - i);
+    }
+
+    LW_TARGET_AVX2 float PositiveFluxRangeAvx2(const float* current, const float* previous, size_t begin, size_t end) {
+        const __m256 zero = _mm256_setzero_ps();
+        __m256 acc = zero;
+        size_t i = begin;
+        for (; i + 8 <= end; i += 8) {
+            const __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(current + i), _mm256_loadu_ps(previous + i));
+            acc = _mm256_add_ps(acc, _mm256_max_ps(diff, zero));
+        }
+        return HorizontalSum256(acc) + PositiveFluxRangeSse2(current, previous, i, end);
+    }
+
+    LW_TARGET_AVX2 void PositiveFluxAvx2(const float* current, const float* previous, size_t count, size_t low_count,
+                                         float* flux, float* flux_low) {
+        low_count = std::min(low_count, count);
+        const float low = PositiveFluxRangeAvx2(current, previous, 0, low_count);
+        *flux_low = low;
+        *flux = low + PositiveFluxRangeAvx2(current, previous, low_count, count);
+    }
+
+    LW_TARGET_AVX2 void MultiplyAvx2(const float* a, const float* b, float* out, size_t count) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        }
+        MultiplySse2(a + i, b + i, out + i, count - i);
+    }
+
+    LW_TARGET_AVX2 float SumAvx2(const float* data, size_t count) {
+        __m256 acc = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            acc = _mm256_add_ps(acc, _mm256_loadu_ps(data + i));
+        }
+        return HorizontalSum256(acc) + SumSse2(data + i, count - i);
+    }
+
+    LW_TARGET_AVX2 void AccumulateStereoAvx2(const float* data, size_t frames, float* mono, float* energy_left, float* energy_right) {
+        const __m256 half = _mm256_set1_ps(0.5f);
+        __m256 acc_left = _mm256_setzero_ps();
+        __m256 acc_right = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 8 <= frames; i += 8) {
+            __m256 l, r;
+            Deinterleave256(_mm256_loadu_ps(data + 2 * i), _mm256_loadu_ps(data + 2 * i + 8), l, r);
+            _mm256_storeu_ps(mono + i, _mm256_mul_ps(_mm256_add_ps(l, r), half));
+            acc_left = _mm256_add_ps(acc_left, _mm256_mul_ps(l, l));
+            acc_right = _mm256_add_ps(acc_right, _mm256_mul_ps(r, r));
+        }
+        float tail_left = 0.0f, tail_right = 0.0f;
+        AccumulateStereoSse2(data + 2 * i, frames - i, mono + i, &tail_left, &tail_right);
+        *energy_left = HorizontalSum256(acc_left) + tail_left;
+        *energy_right = HorizontalSum256(acc_right) + tail_right;
+    }
+
+    const KernelTable kAvx2Table = {
+        "AVX2",
+        MagnitudesAvx2,
+        PositiveFluxAvx2,
+        MultiplyAvx2,
+        SumAvx2,
+        AccumulateStereoAvx2
+    };
+
+    // AVX2 needs both CPU support and OS support for saving the YMM registers (XSAVE/OSXSAVE)
+    bool CpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4] = {};
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx) {
+            return false;
+        }
+        if ((_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+}
+
+const KernelTable* Sse2() {
+    // SSE2 is part of the x64 baseline and the MSVC x86 default (/arch:SSE2)
+    return &kSse2Table;
+}
+
+const KernelTable* Avx2() {
+    static const bool supported = CpuHasAvx2();
+    return supported ? &kAvx2Table : nullptr;
+}
+
+} // namespace SimdKernels
+
+#else
+
+namespace SimdKernels {
+const KernelTable* Sse2() { return nullptr; }
+const KernelTable* Avx2() { return nullptr; }
+} // namespace SimdKernels
+
+#endif
@@ -0,0 +1,52 @@
+// ---------------------------------------------
+// STFT Framer Implementation
+// ---------------------------------------------
+#include "stft_framer.h"
+#include "logging.h"
+#include <algorithm>
+#include <string>
+
+bool StftFramer::Configure(size_t frame_size, size_t hop) {
+    hop = std::clamp<size_t>(hop, 1, std::max<size_t>(frame_size, 1));
+    if (frame_size == frame_size_ && hop == hop_) {
+        return false;
+    }
+    frame_size_ = frame_size;
+    hop_ = hop;
+    ring_.assign(frame_size_, 0.0f);
+    Reset();
+    LOG_DEBUG("[StftFramer] Configured: frameSize=" + std::to_string(frame_size_) +
+              ", hop=" + std::to_string(hop_));
+    return true;
+}
+
+void StftFramer::Reset() {
+    std::fill(ring_.begin(), ring_.end(), 0.0f);
+    write_pos_ = 0;
+    to_next_frame_ = frame_size_;
+}
+
+size_t StftFramer::Push(const float* samples, size_t count) {
+    if (frame_size_ == 0) {
+        return count;
+    }
+    const size_t n = std::min(count, to_next_frame_);
+    size_t copied = 0;
+    while (copied < n) {
+        // Copy in at most two runs: up to the end of the ring, then from its start
+        const size_t run = std::min(n - copied, frame_size_ - write_pos_);
+        std::copy(samples + copied, samples + copied + run, ring_.begin() + write_pos_);
+        copied += run;
+        write_pos_ = (write_pos_ + run) % frame_size_;
+    }
+    to_next_frame_ -= n;
+    return n;
+}
+
+void StftFramer::ReadFrame(float* out) {
+    // The ring always holds exactly the last frame_size_ samples; write_pos_ is the oldest
+    const size_t head = frame_size_ - write_pos_;
+    std::copy(ring_.begin() + write_pos_, ring_.end(), out);
+    std::copy(ring_.begin(), ring_.begin() + write_pos_, out + head);
+    to_next_frame_ = hop_;
+}
@@ -0,0 +1,67 @@
+// ---------------------------------------------
+// STFT Framer
+// Streams mono samples into fixed-size, fixed-hop analysis frames
+// ---------------------------------------------
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Sample ring buffer that cuts a continuous mono stream into overlapping frames.
+ *
+ * Every captured sample is consumed regardless of the device packet size. The first
+ * frame is emitted once frame_size samples have arrived, then one frame every hop
+ * samples, so a packet can yield zero, one or several frames and the analysis rate
+ * is sample_rate / hop independent of the driver's buffer period.
+ *
+ * Typical use per packet:
+ * @code
+ *   size_t offset = 0;
+ *   while (offset < count) {
+ *       offset += framer.Push(mono + offset, count - offset);
+ *       if (framer.FrameReady()) { framer.ReadFrame(frame); ... }
+ *   }
+ * @endcode
+ */
+class StftFramer {
+public:
+    /**
+     * @brief Set frame and hop size; clears buffered samples only if either changes
+     * @param frame_size Samples per frame (the FFT size)
+     * @param hop Samples between the starts of consecutive frames (clamped to [1, frame_size])
+     * @return True if the layout changed and the buffer was reset
+     */
+    bool Configure(size_t frame_size, size_t hop);
+
+    /**
+     * @brief Drop all buffered samples; the next frame needs a full frame_size of input
+     */
+    void Reset();
+
+    /**
+     * @brief Append samples up to the next frame boundary
+     * @param samples Mono samples
+     * @param count Number of samples available
+     * @return Number of samples consumed (stops early when a frame becomes ready)
+     */
+    size_t Push(const float* samples, size_t count);
+
+    /// True when a frame is complete and waiting to be read.
+    bool FrameReady() const { return frame_size_ > 0 && to_next_frame_ == 0; }
+
+    /**
+     * @brief Copy the most recent frame_size samples, oldest first, and arm the next hop
+     * @param out Destination with room for FrameSize() samples
+     */
+    void ReadFrame(float* out);
+
+    size_t FrameSize() const { return frame_size_; }
+    size_t Hop() const { return hop_; }
+
+private:
+    std::vector<float> ring_;   // frame_size_ samples, write_pos_ is the oldest
+    size_t frame_size_ = 0;
+    size_t hop_ = 0;
+    size_t write_pos_ = 0;
+    size_t to_next_frame_ = 0;  // Samples still needed before the next frame is ready
+};
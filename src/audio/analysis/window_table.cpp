@@ -0,0 +1,79 @@
+// ---------------------------------------------
+// Window Table Cache Implementation
+// ---------------------------------------------
+#include "window_table.h"
+#include "simd_kernels.h"
+#include "logging.h"
+#include <cmath>
+#include <string>
+
+namespace {
+    constexpr double kPi = 3.14159265358979323846;
+
+    const char* WindowName(FftWindowType type) {
+        switch (type) {
+            case FftWindowType::Hamming: return "Hamming";
+            case FftWindowType::BlackmanHarris: return "Blackman-Harris";
+            case FftWindowType::FlatTop: return "Flat-top";
+            case FftWindowType::Hann:
+            default: return "Hann";
+        }
+    }
+}
+
+WindowTable::WindowTable(FftWindowType type, size_t size)
+    : type_(type), coefficients_(size, 1.0f) {
+    if (size < 2) {
+        return;
+    }
+
+    // Generalized cosine window: w[n] = a0 - a1*cos(x) + a2*cos(2x) - a3*cos(3x) + a4*cos(4x)
+    double a[5] = { 0.5, 0.5, 0.0, 0.0, 0.0 };
+    switch (type) {
+        case FftWindowType::Hamming:
+            a[0] = 0.54; a[1] = 0.46;
+            break;
+        case FftWindowType::BlackmanHarris:
+            a[0] = 0.35875; a[1] = 0.48829; a[2] = 0.14128; a[3] = 0.01168;
+            break;
+        case FftWindowType::FlatTop:
+            a[0] = 0.21557895; a[1] = 0.41663158; a[2] = 0.277263158; a[3] = 0.083578947; a[4] = 0.006947368;
+            break;
+        case FftWindowType::Hann:
+        default:
+            break;
+    }
+
+    const double step = 2.0 * kPi / static_cast<double>(size - 1);
+    for (size_t n = 0; n < size; n++) {
+        const double x = step * static_cast<double>(n);
+        const double w = a[0] - a[1] * std::cos(x) + a[2] * std::cos(2.0 * x)
+                       - a[3] * std::cos(3.0 * x) + a[4] * std::cos(4.0 * x);
+        coefficients_[n] = static_cast<float>(w);
+    }
+}
+
+void WindowTable::Apply(float* samples, size_t count) const {
+    SimdKernels::Get().multiply(samples, coefficients_.data(), samples, count);
+}
+
+std::shared_ptr<const WindowTable> WindowTableCache::Get(FftWindowType type, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto key = std::make_pair(type, size);
+    auto it = tables_.find(key);
+    if (it != tables_.end()) {
+        return it->second;
+    }
+
+    auto table = std::make_shared<const WindowTable>(type, size);
+    LOG_DEBUG(std::string("[WindowTableCache] Built ") + WindowName(type) +
+              " window: size=" + std::to_string(size));
+    tables_.emplace(key, table);
+    return table;
+}
+
+void WindowTableCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tables_.clear();
+}
@@ -0,0 +1,69 @@
+// ---------------------------------------------
+// Window Table Cache
+// Precomputed FFT analysis windows keyed by (type, size)
+// ---------------------------------------------
+#pragma once
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "constants.h"
+
+/**
+ * @brief Immutable table of window coefficients for one window type and length.
+ *
+ * Coefficients are symmetric (denominator N - 1), matching the Hann window the
+ * analyzer has always used.
+ */
+class WindowTable {
+public:
+    /**
+     * @brief Compute the coefficients
+     * @param type Window shape
+     * @param size Window length in samples
+     */
+    WindowTable(FftWindowType type, size_t size);
+
+    FftWindowType Type() const { return type_; }
+    size_t Size() const { return coefficients_.size(); }
+    const float* Data() const { return coefficients_.data(); }
+
+    /**
+     * @brief Multiply the first count samples in place by the window
+     * @param samples Buffer to window
+     * @param count Number of samples (at most Size())
+     */
+    void Apply(float* samples, size_t count) const;
+
+private:
+    FftWindowType type_;
+    std::vector<float> coefficients_;
+};
+
+/**
+ * @brief Cache of window tables keyed by (type, size).
+ *
+ * Tables are computed once on first use and shared, so switching window type or FFT
+ * size back and forth never recomputes a table.
+ */
+class WindowTableCache {
+public:
+    /**
+     * @brief Get (or build on first use) the table for a window type and length
+     * @param type Window shape
+     * @param size Window length in samples
+     * @return The table (never null)
+     */
+    std::shared_ptr<const WindowTable> Get(FftWindowType type, size_t size);
+
+    /**
+     * @brief Drop all cached tables (tables still held by consumers stay alive)
+     */
+    void Clear();
+
+private:
+    std::mutex mutex_;
+    std::map<std::pair<FftWindowType, size_t>, std::shared_ptr<const WindowTable>> tables_;
+};
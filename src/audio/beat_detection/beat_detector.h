@@ -4,12 +4,15 @@
 #include <string>
 #include <cstddef>
 
+class WorkerPool;
+
 // Beat detection result data
 struct BeatDetectorResult {
     float beat = 0.0f;                  // Beat detection value [0,1]
     float tempo_bpm = 0.0f;             // Detected tempo in BPM
     float confidence = 0.0f;            // Confidence in tempo estimate [0,1]
     float beat_phase = 0.0f;            // Current phase in beat cycle [0,1]
+    float time_to_next_beat = 0.0f;     // Predicted seconds until the next beat (0 without a tempo)
     bool tempo_detected = false;        // Whether tempo has been detected
 };
 
@@ -32,8 +35,9 @@ public:
     
     /**
      * @brief Factory method to create a beat detector
-     * @param algorithm Algorithm index (0=SimpleEnergy, 1=SpectralFluxAuto)
+     * @param algorithm Algorithm index (0=SimpleEnergy, 1=SpectralFluxAuto, 2=PhaseLocked)
+     * @param workers Background pool for deferred analysis; must outlive the detector
      * @return A new beat detector instance
      */
-    static std::unique_ptr<IBeatDetector> Create(int algorithm);
+    static std::unique_ptr<IBeatDetector> Create(int algorithm, WorkerPool& workers);
 };
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "beat_detector_phase_locked.h"
+#include "logging.h"
+#include "../../configuration/configuration_manager.h"
+#include <algorithm>
+#include <cmath>
+
+// Loop constants (per matched onset unless noted)
+constexpr float PHASE_GAIN_LOCKED = 0.25f;   // Share of the phase error corrected while locked
+constexpr float PHASE_GAIN_ACQUIRE = 0.6f;   // Faster pull-in while not locked
+constexpr float PERIOD_GAIN = 0.05f;         // Period change per cycle of phase error (tempo drift)
+constexpr float PERIOD_RANGE = 0.15f;        // Period may drift this far from the estimator tempo
+constexpr float CORRECTION_BEATS = 0.25f;    // Phase corrections are spread over this many beats
+constexpr float ERROR_SMOOTHING = 0.2f;      // Smoothing of the |phase error| lock measure
+constexpr float LOCK_ERROR = 0.1f;           // Locked while the smoothed |phase error| is below this
+constexpr float LOCK_HOLD_BEATS = 4.0f;      // Predicted beats keep firing this long without onsets
+constexpr float MIN_ONSET_INTERVAL = 0.25f;  // Onset refractory time (s) before a tempo is known
+
+namespace {
+
+// Phase error of an onset in cycles: 0 on a predicted beat, positive if the beat came late
+float WrapPhaseError(float phase) {
+    return phase - std::floor(phase + 0.5f);
+}
+
+} // namespace
+
+BeatDetectorPhaseLocked::BeatDetectorPhaseLocked(WorkerPool& workers)
+    : tempo_estimator_(workers)
+{
+    result_.beat = 0.0f;
+    result_.tempo_detected = false;
+    LOG_DEBUG("[BeatDetectorPhaseLocked] Created");
+}
+
+BeatDetectorPhaseLocked::~BeatDetectorPhaseLocked() {
+    Stop();
+    LOG_DEBUG("[BeatDetectorPhaseLocked] Destroyed");
+}
+
+void BeatDetectorPhaseLocked::Start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (is_running_) {
+        return;
+    }
+
+    tempo_estimator_.Start();
+    period_ = 0.0f;
+    estimator_tempo_bpm_ = 0.0f;
+    phase_ = 0.0f;
+    pending_correction_ = 0.0f;
+    phase_error_avg_ = 0.5f;
+    time_since_onset_match_ = 0.0f;
+    locked_ = false;
+    above_threshold_ = false;
+    time_since_onset_ = 0.0f;
+    beat_value_ = 0.0f;
+    result_ = BeatDetectorResult{};
+    is_running_ = true;
+
+    LOG_DEBUG("[BeatDetectorPhaseLocked] Started");
+}
+
+void BeatDetectorPhaseLocked::Stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!is_running_) {
+        return;
+    }
+
+    // Waits for the estimator's in-flight tempo job
+    tempo_estimator_.Stop();
+    is_running_ = false;
+    LOG_DEBUG("[BeatDetectorPhaseLocked] Stopped");
+}
+
+void BeatDetectorPhaseLocked::Process(const std::vector<float>& magnitudes, float flux, float flux_low, float dt) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!is_running_) {
+        return;
+    }
+
+    // One configuration snapshot for the whole frame
+    const Listeningway::ConfigSnapshot config = Listeningway::ConfigurationManager::Current();
+
+    // The estimator only changes its tempo past tempoChangeThreshold, so any change is a
+    // new tempo to lock onto; small drift is left to the loop
+    tempo_estimator_.Process(magnitudes, flux, flux_low, dt);
+    const BeatDetectorResult estimate = tempo_estimator_.GetResult();
+    if (estimate.tempo_detected) {
+        if (estimate.tempo_bpm != estimator_tempo_bpm_) {
+            Relock(estimate.tempo_bpm);
+        }
+    } else if (period_ > 0.0f) {
+        LOG_DEBUG("[BeatDetectorPhaseLocked] Tempo lost");
+        period_ = 0.0f;
+        estimator_tempo_bpm_ = 0.0f;
+        phase_ = 0.0f;
+        pending_correction_ = 0.0f;
+        phase_error_avg_ = 0.5f;
+    }
+
+    // Onsets are rising edges of the low-band flux over the detection threshold
+    time_since_onset_ += dt;
+    time_since_onset_match_ += dt;
+    const float threshold = config->beat.spectralFluxThreshold * config->beat.fluxLowThresholdMultiplier;
+    const bool above = flux_low > threshold;
+    const float refractory = period_ > 0.0f ? 0.5f * period_ : MIN_ONSET_INTERVAL;
+    const bool onset = above && !above_threshold_ && time_since_onset_ >= refractory;
+    above_threshold_ = above;
+    if (onset) {
+        time_since_onset_ = 0.0f;
+    }
+
+    bool predicted_beat = false;
+    bool locked = false;
+    if (period_ > 0.0f) {
+        // Advance the clock. Queued corrections are applied a little every frame and capped
+        // at half the nominal advance, so the phase stays continuous and monotonic
+        const float advance = dt / period_;
+        float correction = pending_correction_ * std::min(1.0f, dt / (CORRECTION_BEATS * period_));
+        correction = std::clamp(correction, -0.5f * advance, 0.5f * advance);
+        pending_correction_ -= correction;
+        phase_ += advance + correction;
+        if (phase_ >= 1.0f) {
+            phase_ -= std::floor(phase_);
+            predicted_beat = true;
+        }
+
+        if (onset) {
+            // Capture range: the induction window while locked, half a beat while acquiring
+            const float window = locked_
+                ? config->beat.beatInductionWindow * (2.0f - estimate.confidence)
+                : 0.5f;
+            CorrectWithOnset(window);
+        }
+        locked = phase_error_avg_ < LOCK_ERROR && time_since_onset_match_ < LOCK_HOLD_BEATS * period_;
+    }
+    if (locked != locked_) {
+        LOG_DEBUG(std::string("[BeatDetectorPhaseLocked] ") + (locked ? "Locked" : "Lost lock") +
+                  " at " + std::to_string(result_.tempo_bpm) + " BPM");
+        locked_ = locked;
+    }
+
+    // Locked, the pulse comes from the clock, so it lands on the beat instead of one onset
+    // detection later; otherwise fall back to the raw onsets
+    if (locked ? predicted_beat : onset) {
+        beat_value_ = 1.0f;
+    }
+    const float decay_rate = period_ > 0.0f
+        ? config->beat.spectralFluxDecayMultiplier / period_
+        : config->beat.falloffDefault;
+    beat_value_ = std::max(0.0f, beat_value_ - decay_rate * dt);
+
+    const float lock_quality = std::clamp(1.0f - phase_error_avg_ / (2.5f * LOCK_ERROR), 0.0f, 1.0f);
+    result_.beat = beat_value_;
+    result_.tempo_detected = period_ > 0.0f;
+    result_.tempo_bpm = period_ > 0.0f ? 60.0f / period_ : 0.0f;
+    result_.confidence = estimate.confidence * lock_quality;
+    result_.beat_phase = phase_;
+    result_.time_to_next_beat = period_ > 0.0f ? (1.0f - phase_) * period_ : 0.0f;
+}
+
+BeatDetectorResult BeatDetectorPhaseLocked::GetResult() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return result_;
+}
+
+void BeatDetectorPhaseLocked::Relock(float tempo_bpm) {
+    LOG_DEBUG("[BeatDetectorPhaseLocked] Tempo estimate " + std::to_string(tempo_bpm) + " BPM, relocking");
+    estimator_tempo_bpm_ = tempo_bpm;
+    period_ = 60.0f / tempo_bpm;
+    // Keep the phase so the clock stays continuous; onsets re-align it
+    pending_correction_ = 0.0f;
+    phase_error_avg_ = std::max(phase_error_avg_, 2.0f * LOCK_ERROR);
+}
+
+void BeatDetectorPhaseLocked::CorrectWithOnset(float window) {
+    // Error against where the clock is heading once the queued correction is applied
+    const float error = WrapPhaseError(phase_ + pending_correction_);
+    if (std::abs(error) > window) {
+        return; // Off-beat onset (syncopation, fill)
+    }
+    pending_correction_ -= (locked_ ? PHASE_GAIN_LOCKED : PHASE_GAIN_ACQUIRE) * error;
+
+    // A late beat means the clock runs fast: lengthen the period, within range of the estimate
+    const float nominal = 60.0f / estimator_tempo_bpm_;
+    period_ = std::clamp(period_ * (1.0f + PERIOD_GAIN * error),
+                         nominal * (1.0f - PERIOD_RANGE), nominal * (1.0f + PERIOD_RANGE));
+
+    phase_error_avg_ += ERROR_SMOOTHING * (std::abs(error) - phase_error_avg_);
+    time_since_onset_match_ = 0.0f;
+}
@@ -0,0 +1,94 @@
+// ---------------------------------------------
+// Phase-Locked Beat Detector
+// Predicts beats with a phase-locked loop corrected by detected onsets
+// ---------------------------------------------
+#pragma once
+#include "beat_detector.h"
+#include "beat_detector_spectral_flux_auto.h"
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Beat tracker that runs a software PLL on the tempo of BeatDetectorSpectralFluxAuto
+ *
+ * The autocorrelation detector only supplies the tempo estimate. This detector keeps its
+ * own beat clock (phase in cycles plus period) that advances every frame, so beat_phase is
+ * a continuous prediction rather than a value reset when a beat is detected:
+ * 1. Every low-band onset near a predicted beat yields a phase error
+ * 2. A proportional-integral loop pulls the period towards the onsets (tempo drift) and
+ *    queues a phase correction that is spread over the next frames, so the phase never
+ *    jumps or runs backwards
+ * 3. The beat pulse fires on the predicted beat while the loop is locked, so shaders see
+ *    it without the onset detection latency; unlocked, it falls back to the onsets
+ */
+class BeatDetectorPhaseLocked : public IBeatDetector {
+public:
+    /**
+     * @brief Constructor
+     * @param workers Pool the tempo estimator submits its analysis jobs to
+     */
+    explicit BeatDetectorPhaseLocked(WorkerPool& workers);
+
+    /**
+     * @brief Destructor
+     */
+    ~BeatDetectorPhaseLocked() override;
+
+    /**
+     * @brief Start processing
+     */
+    void Start() override;
+
+    /**
+     * @brief Stop processing
+     */
+    void Stop() override;
+
+    /**
+     * @brief Advance the beat clock and correct it with this frame's onset
+     * @param magnitudes FFT magnitudes
+     * @param flux Spectral flux value
+     * @param flux_low Low-frequency band limited flux
+     * @param dt Time delta since last frame
+     */
+    void Process(const std::vector<float>& magnitudes, float flux, float flux_low, float dt) override;
+
+    /**
+     * @brief Get the current beat detection result
+     * @return The current beat detection result
+     */
+    BeatDetectorResult GetResult() const override;
+
+private:
+    /**
+     * @brief Re-seed the period from a new tempo estimate (keeps the phase)
+     */
+    void Relock(float tempo_bpm);
+
+    /**
+     * @brief Feed the phase error of an onset into the loop
+     * @param window Largest |phase error| (cycles) accepted as the beat
+     */
+    void CorrectWithOnset(float window);
+
+    BeatDetectorSpectralFluxAuto tempo_estimator_; // Supplies the autocorrelation tempo
+
+    mutable std::mutex mutex_;
+    BeatDetectorResult result_;
+    bool is_running_ = false;
+
+    // Beat clock
+    float period_ = 0.0f;             // Seconds per beat; 0 until the estimator has a tempo
+    float estimator_tempo_bpm_ = 0.0f; // Estimator tempo the loop was last seeded with
+    float phase_ = 0.0f;              // Position in the current beat [0,1)
+    float pending_correction_ = 0.0f; // Phase correction (cycles) not yet applied
+    float phase_error_avg_ = 0.5f;    // Smoothed |phase error| of matched onsets (lock quality)
+    float time_since_onset_match_ = 0.0f; // Seconds since an onset last matched a predicted beat
+    bool locked_ = false;             // Small phase error and recent matching onsets
+
+    // Onset detection on the low-band flux
+    bool above_threshold_ = false;
+    float time_since_onset_ = 0.0f;
+
+    float beat_value_ = 0.0f;
+};
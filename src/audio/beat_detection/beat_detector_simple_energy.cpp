@@ -9,7 +9,7 @@ BeatDetectorSimpleEnergy::BeatDetectorSimpleEnergy()
       last_beat_time_(0.0f),
       total_time_(0.0f),      beat_value_(0.0f),
       flux_threshold_(0.0f),
-      beat_falloff_(Listeningway::ConfigurationManager::Snapshot().beat.falloffDefault)
+      beat_falloff_(Listeningway::ConfigurationManager::Current()->beat.falloffDefault)
 {
     result_.beat = 0.0f;
     result_.tempo_detected = false; // Simple detector doesn't detect tempo
@@ -66,7 +66,8 @@ void BeatDetectorSimpleEnergy::Process(const std::vector<float>& magnitudes, flo
     // Slower adaptation means more stable threshold (less jittery beats)
     flux_threshold_ = flux_threshold_ * 0.98f + beat_flux * 0.02f;    // Check if this is a beat
     bool is_beat = false;
-    const auto config = Listeningway::ConfigurationManager::Snapshot(); // Thread-safe snapshot for beat detection
+    const Listeningway::ConfigSnapshot config_snapshot = Listeningway::ConfigurationManager::Current(); // Lock-free published snapshot
+    const Listeningway::Configuration& config = *config_snapshot;
     if (beat_flux > flux_threshold_ * config.beat.fluxLowThresholdMultiplier && 
         beat_flux > config.beat.fluxMin) {
         
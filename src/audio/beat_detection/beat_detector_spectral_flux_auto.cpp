@@ -6,14 +6,71 @@
 #include <numeric>
 
 // Constants for tempo detection
-constexpr size_t FLUX_HISTORY_SIZE = 2048;
+constexpr float ENVELOPE_RATE = 100.0f;   // Onset envelope samples per second (independent of hop and sample rate)
+constexpr size_t FLUX_HISTORY_SIZE = 2048; // Envelope samples kept for tempo analysis (~20 s)
 constexpr float MIN_TEMPO_BPM = 60.0f;
 constexpr float MAX_TEMPO_BPM = 180.0f;
 constexpr float ANALYSIS_INTERVAL = 2.0f; // Seconds between tempo analysis runs
 
-BeatDetectorSpectralFluxAuto::BeatDetectorSpectralFluxAuto()
-    : is_running_(false),      analysis_pending_(false),
-      flux_threshold_(Listeningway::ConfigurationManager::Snapshot().beat.spectralFluxThreshold),
+namespace {
+
+size_t NextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+/**
+ * @brief Autocorrelation of a 0/1 onset array via Wiener-Khinchin (FFT, |X|^2, IFFT)
+ *
+ * Fills autocorr[lag] = sum(x[i] * x[i + lag]) / (n - lag) for lag in [lag_begin, lag_end)
+ * and leaves the other entries untouched. The input is zero-padded to at least
+ * n + lag_end points so the circular correlation does not wrap into the requested lags.
+ * @param forward,inverse The caller's plans, rebuilt here when the padded size changes
+ * @return False if no FFT plan could be built
+ */
+bool AutocorrelateOnsets(std::unique_ptr<RealFftPlan>& forward, std::unique_ptr<RealFftPlan>& inverse,
+                         const std::vector<float>& onsets, size_t lag_begin, size_t lag_end,
+                         std::vector<float>& autocorr) {
+    const size_t n = onsets.size();
+    const size_t fft_size = NextPowerOfTwo(n + lag_end);
+    if (!forward || forward->Size() != fft_size) {
+        forward = std::make_unique<RealFftPlan>(fft_size, false);
+        inverse = std::make_unique<RealFftPlan>(fft_size, true);
+    }
+    if (!forward->IsValid() || !inverse->IsValid()) {
+        return false;
+    }
+
+    std::vector<kiss_fft_scalar> padded(fft_size, 0.0f);
+    std::copy(onsets.begin(), onsets.end(), padded.begin());
+    std::vector<kiss_fft_cpx> spectrum(fft_size / 2 + 1);
+    forward->Execute(padded.data(), spectrum.data());
+    for (kiss_fft_cpx& bin : spectrum) {
+        bin.r = bin.r * bin.r + bin.i * bin.i;
+        bin.i = 0.0f;
+    }
+    inverse->Execute(spectrum.data(), padded.data());
+
+    // kiss_fftri is unnormalized. Every lag sum of a 0/1 array is an integer, so rounding
+    // removes the FFT round-off and gives exactly the value of the direct sum
+    const float scale = 1.0f / static_cast<float>(fft_size);
+    for (size_t lag = lag_begin; lag < lag_end; lag++) {
+        autocorr[lag] = std::round(padded[lag] * scale) / (n - lag);
+    }
+    return true;
+}
+
+} // namespace
+
+BeatDetectorSpectralFluxAuto::BeatDetectorSpectralFluxAuto(WorkerPool& workers)
+    : workers_(workers),
+      is_running_(false),      analysis_pending_(false),
+      flux_history_(FLUX_HISTORY_SIZE),
+      envelope_(ENVELOPE_RATE),
+      flux_threshold_(Listeningway::ConfigurationManager::Current()->beat.spectralFluxThreshold),
       beat_value_(0.0f),
       current_tempo_bpm_(0.0f),
       tempo_confidence_(0.0f),
@@ -25,6 +82,7 @@ BeatDetectorSpectralFluxAuto::BeatDetectorSpectralFluxAuto()
 {
     result_.beat = 0.0f;
     result_.tempo_detected = false;
+    analysis_flux_.reserve(flux_history_.Capacity());
     LOG_DEBUG("[BeatDetectorSpectralFluxAuto] Created");
 }
 
@@ -42,7 +100,8 @@ void BeatDetectorSpectralFluxAuto::Start() {
     // Initialize state
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        flux_history_.clear();
+        flux_history_.Clear();
+        envelope_.Reset();
         beat_value_ = 0.0f;
         current_tempo_bpm_ = 0.0f;
         tempo_confidence_ = 0.0f;
@@ -53,9 +112,8 @@ void BeatDetectorSpectralFluxAuto::Start() {
         result_.tempo_detected = false;
     }
     
-    // Start analysis thread
+    // Tempo analysis is submitted to the shared worker pool from Process()
     is_running_ = true;
-    analysis_thread_ = std::thread(&BeatDetectorSpectralFluxAuto::TempoAnalysisThread, this);
     
     LOG_DEBUG("[BeatDetectorSpectralFluxAuto] Started");
 }
@@ -67,10 +125,12 @@ void BeatDetectorSpectralFluxAuto::Stop() {
     
     LOG_DEBUG("[BeatDetectorSpectralFluxAuto] Stopping");
     
-    // Stop the analysis thread
+    // A submitted job references this detector, so wait until it has finished (it skips
+    // the analysis once is_running_ is cleared)
     is_running_ = false;
-    if (analysis_thread_.joinable()) {
-        analysis_thread_.join();
+    {
+        std::unique_lock<std::mutex> lock(job_mutex_);
+        job_done_.wait(lock, [this] { return !analysis_pending_.load(); });
     }
     
     LOG_DEBUG("[BeatDetectorSpectralFluxAuto] Stopped");
@@ -81,21 +141,23 @@ void BeatDetectorSpectralFluxAuto::Process(const std::vector<float>& magnitudes,
         return;
     }
     
+    // One configuration snapshot for the whole frame
+    const Listeningway::ConfigSnapshot config = Listeningway::ConfigurationManager::Current();
+    
     // Update time tracking
     total_time_ += dt;
     time_since_last_analysis_ += dt;
     
-    // Store flux for analysis
+    // Store flux for tempo analysis on the fixed envelope grid; the tempo job gets a copy,
+    // so no lock is needed here
+    envelope_.Push(flux_low, dt, flux_history_);
+    
     {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        // Store flux for tempo analysis
-        flux_history_.push_back(flux_low);
-        if (flux_history_.size() > FLUX_HISTORY_SIZE) {
-            flux_history_.pop_front();
-        }        // Update beat detection using low frequency flux
+        // Update beat detection using low frequency flux
         // For this advanced detector, we use a dynamic threshold based on recent history
-        if (flux_low > flux_threshold_ * Listeningway::ConfigurationManager::Snapshot().beat.fluxLowThresholdMultiplier) { // Thread-safe for beat detection thread
+        if (flux_low > flux_threshold_ * config->beat.fluxLowThresholdMultiplier) {
             float beat_gap = 0.0f;
             
             if (current_tempo_bpm_ > 0.0f) {
@@ -103,7 +165,7 @@ void BeatDetectorSpectralFluxAuto::Process(const std::vector<float>& magnitudes,
                 float expected_beat_time = 60.0f / current_tempo_bpm_;
                 beat_gap = total_time_ - time_since_last_beat_;                // Only accept beats that are close to the expected timing
                 // Allow more flexibility for lower confidence levels
-                float window = Listeningway::ConfigurationManager::Snapshot().beat.beatInductionWindow * (1.0f + (1.0f - tempo_confidence_)); // Thread-safe for beat detection thread
+                float window = config->beat.beatInductionWindow * (1.0f + (1.0f - tempo_confidence_));
                 
                 if (beat_gap > expected_beat_time * (1.0f - window) &&
                     beat_gap < expected_beat_time * (1.0f + window)) {
@@ -160,10 +222,10 @@ void BeatDetectorSpectralFluxAuto::Process(const std::vector<float>& magnitudes,
             // Adjust decay rate based on tempo
             // Faster tempo = faster decay
             float beat_length = 60.0f / current_tempo_bpm_;
-            decay_rate = Listeningway::ConfigurationManager::Snapshot().beat.spectralFluxDecayMultiplier / beat_length; // Thread-safe for beat detection thread
+            decay_rate = config->beat.spectralFluxDecayMultiplier / beat_length;
         } else {
             // Default decay rate
-            decay_rate = Listeningway::ConfigurationManager::Snapshot().beat.falloffDefault; // Thread-safe for beat detection thread
+            decay_rate = config->beat.falloffDefault;
         }
         
         beat_value_ = std::max(0.0f, beat_value_ - decay_rate * dt);
@@ -183,6 +245,12 @@ void BeatDetectorSpectralFluxAuto::Process(const std::vector<float>& magnitudes,
     if (time_since_last_analysis_ >= ANALYSIS_INTERVAL && !analysis_pending_.load()) {
         analysis_pending_ = true;
         time_since_last_analysis_ = 0.0f;
+        // Snapshot the history for the job (two memcpys at most); the job only reads this
+        // copy, so neither side locks for the history
+        flux_history_.CopyTo(analysis_flux_);
+        if (!workers_.Submit([this] { RunTempoAnalysis(); })) {
+            analysis_pending_ = false; // Pool not running; try again next interval
+        }
     }
 }
 
@@ -191,60 +259,46 @@ BeatDetectorResult BeatDetectorSpectralFluxAuto::GetResult() const {
     return result_;
 }
 
-void BeatDetectorSpectralFluxAuto::TempoAnalysisThread() {
-    LOG_DEBUG("[BeatDetectorSpectralFluxAuto] Tempo analysis thread started");
-    
-    while (is_running_.load()) {
-        // Wait for new analysis request
-        if (analysis_pending_.load()) {
-            // Remove frequent debug logging - tempo analysis runs every 2 seconds
-            // LOG_DEBUG("[BeatDetectorSpectralFluxAuto] Running tempo analysis");
+void BeatDetectorSpectralFluxAuto::RunTempoAnalysis() {
+    if (is_running_.load()) {
+        if (analysis_flux_.size() > 100) {  // Need enough data for analysis
+            // Perform tempo detection
+            float detected_tempo = DetectTempo(analysis_flux_);
             
-            // Copy flux history for analysis
-            std::vector<float> flux_copy;
-            {
+            // Update tempo if valid
+            if (detected_tempo > 0.0f) {
                 std::lock_guard<std::mutex> lock(mutex_);
-                flux_copy.assign(flux_history_.begin(), flux_history_.end());
-            }
-            
-            if (flux_copy.size() > 100) {  // Need enough data for analysis
-                // Perform tempo detection
-                float detected_tempo = DetectTempo(flux_copy);
-                
-                // Update tempo if valid
-                if (detected_tempo > 0.0f) {
-                    std::lock_guard<std::mutex> lock(mutex_);                    // If we already have a tempo, only change it if the new one is significantly different
-                    if (current_tempo_bpm_ <= 0.0f || 
-                        std::abs(current_tempo_bpm_ - detected_tempo) / current_tempo_bpm_ > Listeningway::ConfigurationManager::Snapshot().beat.tempoChangeThreshold) { // Thread-safe for beat detection thread
-                        
-                        // Only log when tempo actually changes - this is important information
-                        LOG_DEBUG("[BeatDetectorSpectralFluxAuto] Tempo changed from " + 
-                                  std::to_string(current_tempo_bpm_) + " to " + 
-                                  std::to_string(detected_tempo) + " BPM");
-                        
-                        current_tempo_bpm_ = detected_tempo;
-                        // Confidence starts low and increases over time if tempo stays consistent
-                        tempo_confidence_ = std::min(0.8f, tempo_confidence_ + 0.2f);
-                    } else {
-                        // Tempo is consistent, increase confidence
-                        // Remove this logging as it's too frequent and not important
-                        tempo_confidence_ = std::min(1.0f, tempo_confidence_ + 0.1f);
-                    }
+                // If we already have a tempo, only change it if the new one is significantly different
+                if (current_tempo_bpm_ <= 0.0f || 
+                    std::abs(current_tempo_bpm_ - detected_tempo) / current_tempo_bpm_ > Listeningway::ConfigurationManager::Current()->beat.tempoChangeThreshold) {
+                    
+                    // Only log when tempo actually changes - this is important information
+                    LOG_DEBUG("[BeatDetectorSpectralFluxAuto] Tempo changed from " + 
+                              std::to_string(current_tempo_bpm_) + " to " + 
+                              std::to_string(detected_tempo) + " BPM");
+                    
+                    current_tempo_bpm_ = detected_tempo;
+                    // Confidence starts low and increases over time if tempo stays consistent
+                    tempo_confidence_ = std::min(0.8f, tempo_confidence_ + 0.2f);
+                } else {
+                    // Tempo is consistent, increase confidence
+                    tempo_confidence_ = std::min(1.0f, tempo_confidence_ + 0.1f);
                 }
             }
-            
-            analysis_pending_ = false;
         }
-        
-        // Sleep to avoid wasting CPU
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
     
-    LOG_DEBUG("[BeatDetectorSpectralFluxAuto] Tempo analysis thread stopped");
+    // Notify while holding job_mutex_: once Stop() sees the flag cleared the detector may
+    // be destroyed, so nothing here may touch it after the unlock
+    std::lock_guard<std::mutex> lock(job_mutex_);
+    analysis_pending_ = false;
+    job_done_.notify_all();
 }
 
 float BeatDetectorSpectralFluxAuto::DetectTempo(const std::vector<float>& flux_history) {
-    const auto config = Listeningway::ConfigurationManager::Snapshot(); // Thread-safe snapshot for tempo analysis
+    // One configuration snapshot for the whole analysis (not one per flux sample)
+    const Listeningway::ConfigSnapshot config = Listeningway::ConfigurationManager::Current();
+    const float flux_threshold = config->beat.spectralFluxThreshold;
     
     if (flux_history.size() < 100) {
         return 0.0f;
@@ -262,24 +316,31 @@ float BeatDetectorSpectralFluxAuto::DetectTempo(const std::vector<float>& flux_h
     }    // Apply a threshold to get a binary array of beats
     std::vector<float> beat_array(normalized_flux.size(), 0.0f);
     for (size_t i = 0; i < normalized_flux.size(); i++) {
-        if (normalized_flux[i] > Listeningway::ConfigurationManager::Snapshot().beat.spectralFluxThreshold) { // Thread-safe for tempo analysis thread
+        if (normalized_flux[i] > flux_threshold) {
             beat_array[i] = 1.0f;
         }
     }
     
-    // Calculate autocorrelation to find periodicity
-    std::vector<float> autocorr(beat_array.size() / 2);
-    for (size_t lag = 0; lag < autocorr.size(); lag++) {
-        float sum = 0.0f;
-        for (size_t i = 0; i < beat_array.size() - lag; i++) {
-            sum += beat_array[i] * beat_array[i + lag];
-        }
-        autocorr[lag] = sum / (beat_array.size() - lag);
+    // Lags are in envelope samples; Process() resampled the per-hop flux to ENVELOPE_RATE
+    const float SECONDS_PER_SAMPLE = 1.0f / ENVELOPE_RATE;
+    
+    // Only lags inside the tempo window can produce a result; peak detection looks two lags
+    // to either side, and the BPM -> lag conversions below can truncate one lag low
+    std::vector<float> autocorr(beat_array.size() / 2, 0.0f);
+    const size_t window_first = static_cast<size_t>(std::floor(60.0f / MAX_TEMPO_BPM / SECONDS_PER_SAMPLE));
+    const size_t window_last = static_cast<size_t>(std::ceil(60.0f / MIN_TEMPO_BPM / SECONDS_PER_SAMPLE));
+    const size_t lag_begin = window_first > 3 ? window_first - 3 : 0;
+    const size_t lag_end = std::min(window_last + 3, autocorr.size());
+    if (lag_begin >= lag_end ||
+        !AutocorrelateOnsets(autocorr_forward_, autocorr_inverse_, beat_array, lag_begin, lag_end, autocorr)) {
+        return 0.0f;
     }
     
     // Find peaks in autocorrelation
     std::vector<size_t> peaks;
-    for (size_t i = 2; i < autocorr.size() - 2; i++) {
+    const size_t peak_begin = std::max<size_t>(2, lag_begin + 2);
+    const size_t peak_end = std::min(lag_end, autocorr.size()) - 2;
+    for (size_t i = peak_begin; i < peak_end; i++) {
         if (autocorr[i] > autocorr[i-1] && autocorr[i] > autocorr[i-2] &&
             autocorr[i] > autocorr[i+1] && autocorr[i] > autocorr[i+2] &&
             autocorr[i] > 0.1f) {  // Threshold to avoid noise
@@ -291,10 +352,6 @@ float BeatDetectorSpectralFluxAuto::DetectTempo(const std::vector<float>& flux_h
         return 0.0f;  // No clear periodicity
     }
     
-    // Convert peaks to BPM (assuming 43.1 Hz sampling rate - 1024 samples @ 44.1kHz)
-    const float SAMPLE_RATE = 43.1f;
-    const float SECONDS_PER_SAMPLE = 1.0f / SAMPLE_RATE;
-    
     std::vector<float> peak_bpms;
     for (size_t peak : peaks) {
         float period_seconds = peak * SECONDS_PER_SAMPLE;
@@ -319,7 +376,10 @@ float BeatDetectorSpectralFluxAuto::DetectTempo(const std::vector<float>& flux_h
               });
     
     // Account for octave errors (half/double tempo)
-    // Check if we have a strong peak at double/half the tempo
+    // Check if we have a strong peak at double/half the tempo. A strictly periodic onset
+    // train correlates as well at 2T as at T, so ties go to the shorter lag: double tempo
+    // wins when it is nearly as strong (within octaveErrorWeight), while half tempo has
+    // to be stronger than the primary peak by the same factor.
     float primary_bpm = peak_bpms[0];
     float half_bpm = primary_bpm / 2.0f;
     float double_bpm = primary_bpm * 2.0f;
@@ -332,7 +392,7 @@ float BeatDetectorSpectralFluxAuto::DetectTempo(const std::vector<float>& flux_h
                 size_t primary_idx = static_cast<size_t>(60.0f / primary_bpm / SECONDS_PER_SAMPLE);
                 size_t half_idx = static_cast<size_t>(60.0f / half_bpm / SECONDS_PER_SAMPLE);
                 
-                if (autocorr[half_idx] > autocorr[primary_idx] * config.beat.octaveErrorWeight) {
+                if (autocorr[half_idx] * config->beat.octaveErrorWeight > autocorr[primary_idx]) {
                     // Half tempo is significantly stronger
                     primary_bpm = half_bpm;
                 }
@@ -348,8 +408,8 @@ float BeatDetectorSpectralFluxAuto::DetectTempo(const std::vector<float>& flux_h
                 size_t primary_idx = static_cast<size_t>(60.0f / primary_bpm / SECONDS_PER_SAMPLE);
                 size_t double_idx = static_cast<size_t>(60.0f / double_bpm / SECONDS_PER_SAMPLE);
                 
-                if (autocorr[double_idx] > autocorr[primary_idx] * config.beat.octaveErrorWeight) {
-                    // Double tempo is significantly stronger
+                if (autocorr[double_idx] > autocorr[primary_idx] * config->beat.octaveErrorWeight) {
+                    // Double tempo is nearly as strong; prefer the shorter lag
                     primary_bpm = double_bpm;
                 }
                 break;
@@ -4,13 +4,16 @@
 // ---------------------------------------------
 #pragma once
 #include "beat_detector.h"
+#include "flux_history.h"
+#include "../analysis/fft_plan_cache.h"
 #include "settings.h"
+#include "threading.h"
 #include <mutex>
 #include <vector>
-#include <deque>
-#include <thread>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <memory>
 
 /**
  * @brief Advanced beat detector using spectral flux and autocorrelation
@@ -24,8 +27,9 @@ class BeatDetectorSpectralFluxAuto : public IBeatDetector {
 public:
     /**
      * @brief Constructor
+     * @param workers Pool the tempo analysis jobs are submitted to
      */
-    BeatDetectorSpectralFluxAuto();
+    explicit BeatDetectorSpectralFluxAuto(WorkerPool& workers);
     
     /**
      * @brief Destructor
@@ -60,9 +64,9 @@ public:
 private:
     /**
      * @brief Analyze collected flux data to detect tempo
-     * Runs in a separate thread to avoid blocking audio processing
+     * Runs as a WorkerPool job to avoid blocking audio processing
      */
-    void TempoAnalysisThread();
+    void RunTempoAnalysis();
     
     /**
      * @brief Perform autocorrelation to find the tempo
@@ -77,16 +81,27 @@ private:
      */
     void UpdateBeatPhase(float dt);
     
+    WorkerPool& workers_;
     mutable std::mutex mutex_;
     BeatDetectorResult result_;
     
-    // Thread control variables
+    // Tempo job control: analysis_pending_ is set on submit and cleared under job_mutex_
+    // when the job finishes, so Stop() can wait for an in-flight job. While it is set the
+    // job owns analysis_flux_; Process() only refills it once the flag is clear again
     std::atomic_bool is_running_{false};
     std::atomic_bool analysis_pending_{false};
-    std::thread analysis_thread_;
+    std::mutex job_mutex_;
+    std::condition_variable job_done_;
     
     // Beat detection state
-    std::deque<float> flux_history_;
+    FluxHistory flux_history_;          // Low-band flux envelope; only Process() and Start() touch it
+    EnvelopeResampler envelope_;        // Puts the per-hop flux on the envelope grid
+    std::vector<float> analysis_flux_;  // History snapshot handed to the pending tempo job
+    // Autocorrelation plans, only used by the tempo job. They are not taken from the
+    // analyzer's FftPlanCache: kiss_fftr keeps scratch space in the plan, so a real plan
+    // must never run on two threads at once
+    std::unique_ptr<RealFftPlan> autocorr_forward_;
+    std::unique_ptr<RealFftPlan> autocorr_inverse_;
     float flux_threshold_ = 0.0f;
     float beat_value_ = 0.0f;
     
@@ -0,0 +1,61 @@
+// ---------------------------------------------
+// Flux History Implementation
+// ---------------------------------------------
+#include "flux_history.h"
+#include <algorithm>
+#include <cstring>
+
+FluxHistory::FluxHistory(size_t min_capacity) {
+    size_t capacity = 1;
+    while (capacity < min_capacity) {
+        capacity <<= 1;
+    }
+    buffer_.assign(capacity, 0.0f);
+    mask_ = capacity - 1;
+}
+
+void FluxHistory::Clear() {
+    write_pos_ = 0;
+}
+
+FluxHistory::Spans FluxHistory::Contents() const {
+    const size_t size = Size();
+    // Once full the oldest value sits at the write position, so the history wraps there
+    const size_t start = (write_pos_ - size) & mask_;
+    const size_t first = (start + size <= buffer_.size()) ? size : buffer_.size() - start;
+    return Spans{ buffer_.data() + start, first, buffer_.data(), size - first };
+}
+
+void FluxHistory::CopyTo(std::vector<float>& out) const {
+    const Spans spans = Contents();
+    out.resize(spans.first_size + spans.second_size);
+    if (spans.first_size > 0) {
+        std::memcpy(out.data(), spans.first, spans.first_size * sizeof(float));
+    }
+    if (spans.second_size > 0) {
+        std::memcpy(out.data() + spans.first_size, spans.second, spans.second_size * sizeof(float));
+    }
+}
+
+void EnvelopeResampler::Reset() {
+    previous_ = 0.0f;
+    cell_peak_ = 0.0f;
+    until_next_ = 0.0f;
+}
+
+void EnvelopeResampler::Push(float value, float dt, FluxHistory& history) {
+    if (!(dt > 0.0f)) {
+        return;
+    }
+    float t = until_next_;
+    while (t < dt) {
+        const float interpolated = previous_ + (value - previous_) * (t / dt);
+        history.Push(std::max(interpolated, cell_peak_));
+        cell_peak_ = 0.0f;
+        t += period_;
+    }
+    until_next_ = t - dt;
+    // This frame lies inside the cell that ends at the next grid point
+    cell_peak_ = std::max(cell_peak_, value);
+    previous_ = value;
+}
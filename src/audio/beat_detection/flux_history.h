@@ -0,0 +1,98 @@
+// ---------------------------------------------
+// Flux History
+// Fixed-rate onset envelope kept in a fixed-capacity ring
+// ---------------------------------------------
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Ring of the last Capacity() flux values, oldest overwritten first.
+ *
+ * Capacity is rounded up to a power of two so the write position wraps with a mask.
+ * The contents are always at most two contiguous runs of the buffer, which Contents()
+ * exposes directly and CopyTo() copies with two memcpys. Not thread-safe: one thread
+ * pushes and reads; hand a CopyTo() snapshot to other threads.
+ */
+class FluxHistory {
+public:
+    /**
+     * @brief Contents oldest first: first[0..first_size) then second[0..second_size)
+     */
+    struct Spans {
+        const float* first;
+        size_t first_size;
+        const float* second;
+        size_t second_size;
+    };
+
+    /**
+     * @param min_capacity Minimum number of values the history keeps
+     */
+    explicit FluxHistory(size_t min_capacity);
+
+    /// Drop all values (capacity is kept).
+    void Clear();
+
+    /// Append a value, dropping the oldest one when full.
+    void Push(float value) {
+        buffer_[write_pos_ & mask_] = value;
+        write_pos_++;
+    }
+
+    /// Number of values held (at most Capacity()).
+    size_t Size() const { return write_pos_ < buffer_.size() ? write_pos_ : buffer_.size(); }
+
+    size_t Capacity() const { return buffer_.size(); }
+
+    /**
+     * @brief View of the held values without copying (valid until the next Push/Clear)
+     */
+    Spans Contents() const;
+
+    /**
+     * @brief Copy the held values, oldest first, into out (resized to Size())
+     */
+    void CopyTo(std::vector<float>& out) const;
+
+private:
+    std::vector<float> buffer_;
+    size_t mask_ = 0;
+    size_t write_pos_ = 0; // Values pushed since Clear(); only ever grows
+};
+
+/**
+ * @brief Resamples the per-frame flux (one value every hop) onto a fixed envelope rate.
+ *
+ * The analysis frame rate is sample_rate / hopSize, so it changes with the device mix
+ * format and the hop setting. Tempo estimation works in envelope samples, so the flux is
+ * put on a fixed grid first: every grid point gets the value interpolated between the two
+ * surrounding frames, or the largest frame that fell inside its cell if that is higher, so
+ * short onsets survive downsampling.
+ */
+class EnvelopeResampler {
+public:
+    /**
+     * @param output_rate Envelope samples per second
+     */
+    explicit EnvelopeResampler(float output_rate) : period_(1.0f / output_rate) {}
+
+    float Rate() const { return 1.0f / period_; }
+
+    /// Forget the previous frame (next Push starts a new envelope).
+    void Reset();
+
+    /**
+     * @brief Add one analysis frame and append the grid points it completes
+     * @param value Flux of the frame (non-negative)
+     * @param dt Time since the previous frame in seconds
+     * @param history Receives the envelope samples
+     */
+    void Push(float value, float dt, FluxHistory& history);
+
+private:
+    float period_;
+    float previous_ = 0.0f;   // Value of the previous frame
+    float cell_peak_ = 0.0f;  // Largest frame inside the grid cell being filled
+    float until_next_ = 0.0f; // Time from the previous frame to the next grid point
+};
@@ -122,6 +122,12 @@ std::string GetAudioCaptureProviderName(const std::string& providerCode) {
     return "Unknown";
 }
 
+// Overlay API: Get the capture-to-analysis queue counters
+SampleRing::Stats GetAudioCaptureRingStats() {
+    if (!g_audio_capture_manager) return {};
+    return g_audio_capture_manager->GetSampleRingStats();
+}
+
 // Overlay API: Switch provider and restart capture thread if running
 bool SwitchAudioCaptureProviderAndRestart(int providerType, std::atomic_bool& running, std::thread& thread, AudioAnalysisData& data) {
     auto config = ConfigurationManager::Snapshot();
@@ -40,6 +40,12 @@ std::vector<AudioProviderInfo> GetAvailableAudioCaptureProviders();
  */
 std::string GetAudioCaptureProviderName(const std::string& providerCode);
 
+/**
+ * @brief Gets the capture-to-analysis queue counters of the current provider
+ * @return Overflow/underrun statistics since capture started
+ */
+SampleRing::Stats GetAudioCaptureRingStats();
+
 // Overlay API: Switch provider and restart capture thread if running
 bool SwitchAudioCaptureProviderAndRestart(int providerType, std::atomic_bool& running, std::thread& thread, AudioAnalysisData& data);
 
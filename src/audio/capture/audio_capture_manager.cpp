@@ -101,6 +101,10 @@ std::vector<AudioProviderInfo> AudioCaptureManager::GetAvailableProviderInfos()
     return infos;
 }
 
+SampleRing::Stats AudioCaptureManager::GetSampleRingStats() const {
+    return current_provider_ ? current_provider_->GetSampleRingStats() : SampleRing::Stats{};
+}
+
 std::string AudioCaptureManager::GetProviderName(AudioCaptureProviderType type) const {
     IAudioCaptureProvider* provider = FindProvider(type);
     if (provider) {
@@ -394,6 +398,7 @@ bool AudioCaptureManager::ApplyConfiguration(const Listeningway::Configuration&
         }
         // Clear analysis data so UI doesn't show stale values
         g_audio_data = AudioAnalysisData(config.frequency.bands);
+        g_audio_analyzer.PublishFrame(g_audio_data);
         last_activates_capture = false;
         return true;
     }
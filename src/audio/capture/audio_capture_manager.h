@@ -39,6 +39,7 @@ public:
     bool SwitchProviderAndRestart(AudioCaptureProviderType type, const Listeningway::Configuration& config, std::atomic_bool& running, std::thread& thread, AudioAnalysisData& data);
     bool SwitchProviderByCodeAndRestart(const std::string& providerCode, const Listeningway::Configuration& config, std::atomic_bool& running, std::thread& thread, AudioAnalysisData& data);
     std::vector<AudioProviderInfo> GetAvailableProviderInfos() const;
+    SampleRing::Stats GetSampleRingStats() const;
     bool RestartAudioSystem(const Listeningway::Configuration& config);
     void StopAudioSystem();
     bool ApplyConfiguration(const Listeningway::Configuration& config);
@@ -9,6 +9,7 @@
 #include <mutex>
 #include <string>
 #include "audio/analysis/audio_analysis.h"
+#include "audio/capture/sample_ring.h"
 
 /**
  * @brief Audio capture provider types
@@ -60,7 +61,8 @@ public:
      * @param thread Thread object (will be started)
      * @param data Analysis data to be updated by the thread
      * @return true if capture started successfully
-     * @note Audio data synchronization is handled internally via ThreadSafetyManager
+     * @note data is only touched by the provider's worker threads while capture runs;
+     *       finished frames reach the render thread through AudioAnalyzer::CopyLatestFrame()
      */
     virtual bool StartCapture(const Listeningway::Configuration& config, 
                              std::atomic_bool& running, 
@@ -85,6 +87,12 @@ public:
      */
     virtual void ResetRestartFlags() = 0;
 
+    /**
+     * @brief Counters of the capture-to-analysis sample queue
+     * @return Overflow/underrun statistics (zeros for providers without a queue)
+     */
+    virtual SampleRing::Stats GetSampleRingStats() const { return {}; }
+
     /**
      * @brief Initializes the provider
      * @return true if initialization succeeded
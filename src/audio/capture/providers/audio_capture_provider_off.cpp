@@ -6,7 +6,6 @@
 // ---------------------------------------------
 #include "audio/capture/providers/audio_capture_provider_off.h"
 #include "audio/capture/providers/audio_capture_provider.h"
-#include "../../core/thread_safety_manager.h"
 #include <string>
 #include <thread>
 #include <chrono>
@@ -21,12 +20,10 @@ bool AudioCaptureProviderOff::StartCapture(const Listeningway::Configuration& co
     thread = std::thread([&, config]() {
         while (running.load()) {
             // Provide zero/dummy audio data
-            {
-                LOCK_AUDIO_DATA();
-                data.volume = 0.0f;
-                std::fill(data.freq_bands.begin(), data.freq_bands.end(), 0.0f);
-                data.beat = 0.0f;
-            }
+            data.volume = 0.0f;
+            std::fill(data.freq_bands.begin(), data.freq_bands.end(), 0.0f);
+            data.beat = 0.0f;
+            g_audio_analyzer.PublishFrame(data);
             // Sleep to avoid busy waiting
             std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
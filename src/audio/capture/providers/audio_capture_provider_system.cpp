@@ -4,7 +4,7 @@
 #include "audio/capture/providers/audio_capture_provider.h"
 #include "analysis/audio_analysis.h"
 #include "../../utils/logging.h"
-#include "../../core/thread_safety_manager.h"
+#include "../../core/constants.h"
 #include <mmdeviceapi.h>
 #include <audioclient.h>
 #include <vector>
@@ -12,11 +12,103 @@
 #include <combaseapi.h>
 #include <chrono>
 #include <thread>
+#include <algorithm>
 
 // Static member definitions
 std::atomic_bool AudioCaptureProviderSystem::device_change_pending_(false);
 IMMDeviceEnumerator* AudioCaptureProviderSystem::device_enumerator_ = nullptr;
 AudioCaptureProviderSystem::DeviceNotificationClient* AudioCaptureProviderSystem::notification_client_ = nullptr;
+SampleRing AudioCaptureProviderSystem::sample_ring_;
+
+namespace {
+    /**
+     * @brief Runs AnalyzeAudioBuffer on its own thread, fed from the sample ring.
+     *
+     * The capture thread only copies packets into the ring and signals the event, so a slow
+     * analysis frame (large FFT, beat detection) never delays ReleaseBuffer. Stopped and
+     * joined on destruction, so every exit path of the capture thread shuts it down.
+     */
+    class AnalysisThread {
+    public:
+        AnalysisThread(SampleRing& ring, size_t channels, size_t max_packet_frames, AudioAnalysisData& data)
+            : ring_(ring), channels_(channels), chunk_(max_packet_frames * channels), data_(data) {}
+
+        ~AnalysisThread() { Stop(); }
+
+        AnalysisThread(const AnalysisThread&) = delete;
+        AnalysisThread& operator=(const AnalysisThread&) = delete;
+
+        bool Start() {
+            event_ = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+            if (!event_) {
+                return false;
+            }
+            running_ = true;
+            thread_ = std::thread([this]() { Run(); });
+            return true;
+        }
+
+        void Stop() {
+            running_ = false;
+            if (event_) SetEvent(event_);
+            if (thread_.joinable()) thread_.join();
+            if (event_) {
+                CloseHandle(event_);
+                event_ = nullptr;
+            }
+        }
+
+        // Called by the capture thread after each packet written to the ring
+        void Notify() { SetEvent(event_); }
+
+    private:
+        void Run() {
+            try {
+                bool streaming = false; // Data arrived since the last stall
+                while (running_.load()) {
+                    const DWORD wait = WaitForSingleObject(event_, 200);
+                    if (!running_.load()) {
+                        break;
+                    }
+                    if (wait == WAIT_TIMEOUT) {
+                        // A whole wait without a packet while audio was flowing: the analysis
+                        // thread is starved. Counted once per stall, not once per wait
+                        if (streaming && Listeningway::RuntimeFlags::AnalysisEnabled()) {
+                            ring_.NoteUnderrun();
+                        }
+                        streaming = false;
+                        continue;
+                    }
+                    if (wait != WAIT_OBJECT_0) {
+                        continue;
+                    }
+                    // The event is set per packet but each wakeup drains the whole ring, so a
+                    // wakeup may find its packet already consumed; that is not an underrun.
+                    // Chunks are whole frames because packets are written whole and the chunk
+                    // size is a multiple of the channel count
+                    size_t count = ring_.Read(chunk_.data(), chunk_.size());
+                    while (count > 0) {
+                        streaming = true;
+                        g_audio_analyzer.AnalyzeAudioBuffer(chunk_.data(), count / channels_, channels_, data_);
+                        count = ring_.Read(chunk_.data(), chunk_.size());
+                    }
+                }
+            } catch (const std::exception& ex) {
+                LOG_ERROR(std::string("[SystemAudioProvider] Exception in analysis thread: ") + ex.what());
+            } catch (...) {
+                LOG_ERROR("[SystemAudioProvider] Unknown exception in analysis thread.");
+            }
+        }
+
+        SampleRing& ring_;
+        size_t channels_;
+        std::vector<float> chunk_;     // One device buffer of interleaved samples
+        AudioAnalysisData& data_;      // Private to the analysis thread while it runs
+        HANDLE event_ = nullptr;
+        std::atomic_bool running_{ false };
+        std::thread thread_;
+    };
+}
 
 // Notification client for device changes
 class AudioCaptureProviderSystem::DeviceNotificationClient : public IMMNotificationClient {
@@ -248,6 +340,21 @@ bool AudioCaptureProviderSystem::StartCapture(const Listeningway::Configuration&
                 return;
             }
             
+            // Queue DEFAULT_SAMPLE_RING_SECONDS of audio (at least a few device buffers) between
+            // capture and analysis, then start the analysis thread that drains it
+            const size_t channels = res.pwfx->nChannels;
+            const size_t ring_frames = std::max<size_t>(
+                static_cast<size_t>(DEFAULT_SAMPLE_RING_SECONDS * res.pwfx->nSamplesPerSec), 4 * bufferFrameCount);
+            sample_ring_.Reset(ring_frames * channels);
+            g_audio_analyzer.SetStreamSampleRate(static_cast<float>(res.pwfx->nSamplesPerSec));
+            AnalysisThread analysis(sample_ring_, channels, bufferFrameCount, data);
+            if (!analysis.Start()) {
+                LOG_ERROR("[SystemAudioProvider] Failed to start analysis thread.");
+                running = false;
+                CoUninitialize();
+                return;
+            }
+            
             LOG_DEBUG("[SystemAudioProvider] Entering main capture loop.");
             
             // Main capture loop
@@ -269,20 +376,16 @@ bool AudioCaptureProviderSystem::StartCapture(const Listeningway::Configuration&
                       hr = res.pCaptureClient->GetBuffer(&pData, &numFramesAvailable, &flags, &devicePosition, &qpcPosition);
                     if (SUCCEEDED(hr)) {
                         if (!(flags & AUDCLNT_BUFFERFLAGS_SILENT) && pData && numFramesAvailable > 0 && isFloatFormat) {
-                            // Check if analysis is enabled in config (thread-safe snapshot)
-                            if (!Listeningway::ConfigurationManager::Snapshot().audio.analysisEnabled) {
+                            // Skip packets while analysis is disabled (relaxed atomic load, no lock)
+                            if (!Listeningway::RuntimeFlags::AnalysisEnabled()) {
                                 res.pCaptureClient->ReleaseBuffer(numFramesAvailable);
                                 continue;
                             }
                             
-                            // Use centralized thread safety for audio data access
-                            {
-                                LOCK_AUDIO_DATA();
-                                extern AudioAnalyzer g_audio_analyzer;
-                                g_audio_analyzer.AnalyzeAudioBuffer(reinterpret_cast<float*>(pData), 
-                                                                  numFramesAvailable, 
-                                                                  res.pwfx->nChannels, 
-                                                                  data);
+                            // Only copy the packet here; the analysis thread does the DSP work.
+                            // A full ring drops the packet (counted as an overflow) rather than block.
+                            if (sample_ring_.Write(reinterpret_cast<const float*>(pData), numFramesAvailable * channels)) {
+                                analysis.Notify();
                             }
                         }
                         res.pCaptureClient->ReleaseBuffer(numFramesAvailable);
@@ -332,6 +435,7 @@ bool AudioCaptureProviderSystem::StartCapture(const Listeningway::Configuration&
             }
             
             LOG_DEBUG("[SystemAudioProvider] Exiting capture loop.");
+            analysis.Stop();
             CoUninitialize();
             running = false;
             LOG_DEBUG("[SystemAudioProvider] Audio capture thread stopped.");
@@ -14,6 +14,7 @@ private:
     static std::atomic_bool device_change_pending_;
     static IMMDeviceEnumerator* device_enumerator_;
     static DeviceNotificationClient* notification_client_;
+    static SampleRing sample_ring_;   // Capture thread -> analysis thread
 
 public:
     AudioCaptureProviderSystem() = default;
@@ -43,6 +44,10 @@ public:
         device_change_pending_ = false;
     }
 
+    SampleRing::Stats GetSampleRingStats() const override {
+        return sample_ring_.GetStats();
+    }
+
     bool Initialize() override;
     void Uninitialize() override;
 
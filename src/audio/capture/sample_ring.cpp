@@ -0,0 +1,67 @@
+// ---------------------------------------------
+// Sample Ring Implementation
+// ---------------------------------------------
+#include "sample_ring.h"
+#include "logging.h"
+#include <algorithm>
+#include <string>
+
+void SampleRing::Reset(size_t min_capacity) {
+    size_t capacity = 1;
+    while (capacity < min_capacity) {
+        capacity <<= 1;
+    }
+    if (buffer_.size() != capacity) {
+        buffer_.assign(capacity, 0.0f);
+    }
+    mask_ = capacity - 1;
+    write_pos_.store(0, std::memory_order_relaxed);
+    read_pos_.store(0, std::memory_order_relaxed);
+    overflows_.store(0, std::memory_order_relaxed);
+    dropped_samples_.store(0, std::memory_order_relaxed);
+    underruns_.store(0, std::memory_order_relaxed);
+    LOG_DEBUG("[SampleRing] Capacity " + std::to_string(capacity) + " samples");
+}
+
+bool SampleRing::Write(const float* samples, size_t count) {
+    const size_t write = write_pos_.load(std::memory_order_relaxed);
+    const size_t read = read_pos_.load(std::memory_order_acquire);
+    if (count > buffer_.size() - (write - read)) {
+        overflows_.fetch_add(1, std::memory_order_relaxed);
+        dropped_samples_.fetch_add(count, std::memory_order_relaxed);
+        return false;
+    }
+    // Copy in at most two runs: up to the end of the buffer, then from its start
+    const size_t start = write & mask_;
+    const size_t first = std::min(count, buffer_.size() - start);
+    std::copy(samples, samples + first, buffer_.begin() + start);
+    std::copy(samples + first, samples + count, buffer_.begin());
+    write_pos_.store(write + count, std::memory_order_release);
+    return true;
+}
+
+size_t SampleRing::Read(float* out, size_t max_count) {
+    const size_t read = read_pos_.load(std::memory_order_relaxed);
+    const size_t write = write_pos_.load(std::memory_order_acquire);
+    const size_t count = std::min(max_count, write - read);
+    const size_t start = read & mask_;
+    const size_t first = std::min(count, buffer_.size() - start);
+    std::copy(buffer_.begin() + start, buffer_.begin() + start + first, out);
+    std::copy(buffer_.begin(), buffer_.begin() + (count - first), out + first);
+    read_pos_.store(read + count, std::memory_order_release);
+    return count;
+}
+
+size_t SampleRing::Available() const {
+    return write_pos_.load(std::memory_order_acquire) - read_pos_.load(std::memory_order_acquire);
+}
+
+SampleRing::Stats SampleRing::GetStats() const {
+    Stats stats;
+    stats.written_samples = write_pos_.load(std::memory_order_relaxed);
+    stats.read_samples = read_pos_.load(std::memory_order_relaxed);
+    stats.overflows = overflows_.load(std::memory_order_relaxed);
+    stats.dropped_samples = dropped_samples_.load(std::memory_order_relaxed);
+    stats.underruns = underruns_.load(std::memory_order_relaxed);
+    return stats;
+}
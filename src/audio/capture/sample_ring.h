@@ -0,0 +1,76 @@
+// ---------------------------------------------
+// Sample Ring
+// Lock-free single-producer/single-consumer queue of interleaved float samples
+// ---------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Wait-free SPSC ring of float samples between the capture and analysis threads.
+ *
+ * The capture thread is the only producer and the analysis thread the only consumer.
+ * Capacity is rounded up to a power of two so positions wrap with a mask. Positions only
+ * ever grow; the writer publishes its position with release ordering after copying, and
+ * the reader does the same for its position, so neither side ever waits on the other.
+ *
+ * Packets are written all-or-nothing: a packet that does not fit is dropped whole and
+ * counted as an overflow, which keeps interleaved frames aligned for the reader.
+ */
+class SampleRing {
+public:
+    /**
+     * @brief Counters since the last Reset()
+     */
+    struct Stats {
+        uint64_t written_samples = 0;   // Samples accepted by Write()
+        uint64_t read_samples = 0;      // Samples returned by Read()
+        uint64_t overflows = 0;         // Packets dropped because the ring was full
+        uint64_t dropped_samples = 0;   // Samples in those packets
+        uint64_t underruns = 0;         // Stalls: no data for a whole reader wait after data had been flowing
+    };
+
+    /**
+     * @brief Size the ring and clear positions and counters (no reader or writer may be active)
+     * @param min_capacity Minimum number of samples the ring must hold
+     */
+    void Reset(size_t min_capacity);
+
+    /**
+     * @brief Append a packet (producer thread only)
+     * @return False if the packet did not fit and was dropped
+     */
+    bool Write(const float* samples, size_t count);
+
+    /**
+     * @brief Take up to max_count samples, oldest first (consumer thread only)
+     * @return Number of samples copied to out
+     */
+    size_t Read(float* out, size_t max_count);
+
+    /**
+     * @brief Record that the consumer was starved of data while capture was active (consumer thread only)
+     */
+    void NoteUnderrun() { underruns_.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Samples currently queued (approximate while the other side is active).
+    size_t Available() const;
+
+    size_t Capacity() const { return buffer_.size(); }
+
+    /**
+     * @brief Snapshot of the counters (any thread)
+     */
+    Stats GetStats() const;
+
+private:
+    std::vector<float> buffer_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> write_pos_{ 0 };   // Advanced by the producer
+    alignas(64) std::atomic<size_t> read_pos_{ 0 };    // Advanced by the consumer
+    alignas(64) std::atomic<uint64_t> overflows_{ 0 };
+    std::atomic<uint64_t> dropped_samples_{ 0 };
+    std::atomic<uint64_t> underruns_{ 0 };
+};
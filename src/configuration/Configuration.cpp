@@ -1,4 +1,5 @@
 #include "Configuration.h"
+#include "iconfiguration_change_listener.h"
 #include "logging.h"
 #include "settings.h"
 #include <fstream>
@@ -8,9 +9,85 @@
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
+#include <tuple>
 
 namespace Listeningway {
 
+bool Configuration::Audio::operator==(const Audio& other) const {
+    return std::tie(analysisEnabled, captureProviderCode, panOffset) ==
+           std::tie(other.analysisEnabled, other.captureProviderCode, other.panOffset);
+}
+
+bool Configuration::BeatDetection::operator==(const BeatDetection& other) const {
+    return std::tie(algorithm, falloffDefault, timeScale, timeInitial, timeMin, timeDivisor,
+                    spectralFluxThreshold, spectralFluxDecayMultiplier, tempoChangeThreshold,
+                    beatInductionWindow, octaveErrorWeight, minFreq, maxFreq, fluxLowAlpha,
+                    fluxLowThresholdMultiplier, fluxMin) ==
+           std::tie(other.algorithm, other.falloffDefault, other.timeScale, other.timeInitial, other.timeMin, other.timeDivisor,
+                    other.spectralFluxThreshold, other.spectralFluxDecayMultiplier, other.tempoChangeThreshold,
+                    other.beatInductionWindow, other.octaveErrorWeight, other.minFreq, other.maxFreq, other.fluxLowAlpha,
+                    other.fluxLowThresholdMultiplier, other.fluxMin);
+}
+
+bool Configuration::FrequencyBands::operator==(const FrequencyBands& other) const {
+    return std::tie(logScaleEnabled, logStrength, minFreq, maxFreq, equalizerBands, equalizerWidth,
+                    amplifier, bands, fftSize, hopSize, windowType, bandNorm) ==
+           std::tie(other.logScaleEnabled, other.logStrength, other.minFreq, other.maxFreq, other.equalizerBands, other.equalizerWidth,
+                    other.amplifier, other.bands, other.fftSize, other.hopSize, other.windowType, other.bandNorm);
+}
+
+bool Configuration::Smoothing::operator==(const Smoothing& other) const {
+    return std::tie(panMinCutoff, panBeta, volumeMinCutoff, volumeBeta, tempoMinCutoff, tempoBeta, derivativeCutoff) ==
+           std::tie(other.panMinCutoff, other.panBeta, other.volumeMinCutoff, other.volumeBeta,
+                    other.tempoMinCutoff, other.tempoBeta, other.derivativeCutoff);
+}
+
+bool Configuration::Debug::operator==(const Debug& other) const {
+    return std::tie(debugEnabled, overlayEnabled) == std::tie(other.debugEnabled, other.overlayEnabled);
+}
+
+bool Configuration::operator==(const Configuration& other) const {
+    return audio == other.audio && beat == other.beat && frequency == other.frequency &&
+           smoothing == other.smoothing && sample_rate == other.sample_rate && debug == other.debug;
+}
+
+ConfigSectionMask ChangedSections(const Configuration& before, const Configuration& after) {
+    ConfigSectionMask changed = 0;
+    const auto& f0 = before.frequency;
+    const auto& f1 = after.frequency;
+    if (std::tie(f0.bands, f0.fftSize, f0.hopSize, f0.windowType, f0.minFreq, f0.maxFreq, f0.logScaleEnabled) !=
+            std::tie(f1.bands, f1.fftSize, f1.hopSize, f1.windowType, f1.minFreq, f1.maxFreq, f1.logScaleEnabled) ||
+        before.sample_rate != after.sample_rate) {
+        changed |= SectionBit(ConfigSection::FrequencyMapping);
+    }
+    if (std::tie(f0.equalizerBands, f0.equalizerWidth, f0.logStrength, f0.bandNorm, f0.amplifier) !=
+        std::tie(f1.equalizerBands, f1.equalizerWidth, f1.logStrength, f1.bandNorm, f1.amplifier)) {
+        changed |= SectionBit(ConfigSection::Equalizer);
+    }
+    if (before.beat.algorithm != after.beat.algorithm) {
+        changed |= SectionBit(ConfigSection::BeatAlgorithm);
+    }
+    Configuration::BeatDetection beat0 = before.beat;
+    beat0.algorithm = after.beat.algorithm;
+    if (beat0 != after.beat) {
+        changed |= SectionBit(ConfigSection::BeatParams);
+    }
+    if (before.audio.captureProviderCode != after.audio.captureProviderCode ||
+        before.audio.analysisEnabled != after.audio.analysisEnabled) {
+        changed |= SectionBit(ConfigSection::CaptureProvider);
+    }
+    if (before.audio.panOffset != after.audio.panOffset) {
+        changed |= SectionBit(ConfigSection::Spatialization);
+    }
+    if (before.smoothing != after.smoothing) {
+        changed |= SectionBit(ConfigSection::Smoothing);
+    }
+    if (before.debug != after.debug) {
+        changed |= SectionBit(ConfigSection::Debug);
+    }
+    return changed;
+}
+
 bool Configuration::Save() const {
     return SaveToJson(GetDefaultConfigPath());
 }
@@ -30,11 +107,19 @@ bool Configuration::Validate() {
     
     // Validate audio settings
     // audio.captureProvider = std::max(-1, audio.captureProvider); // (legacy, remove after migration)
-    audio.panSmoothing = std::clamp(audio.panSmoothing, 0.0f, 1.0f);
     audio.panOffset = std::clamp(audio.panOffset, -1.0f, 1.0f);
     
+    // Validate smoothing settings
+    smoothing.panMinCutoff = std::clamp(smoothing.panMinCutoff, 0.0f, 30.0f);
+    smoothing.panBeta = std::clamp(smoothing.panBeta, 0.0f, 10.0f);
+    smoothing.volumeMinCutoff = std::clamp(smoothing.volumeMinCutoff, 0.0f, 30.0f);
+    smoothing.volumeBeta = std::clamp(smoothing.volumeBeta, 0.0f, 10.0f);
+    smoothing.tempoMinCutoff = std::clamp(smoothing.tempoMinCutoff, 0.0f, 30.0f);
+    smoothing.tempoBeta = std::clamp(smoothing.tempoBeta, 0.0f, 10.0f);
+    smoothing.derivativeCutoff = std::clamp(smoothing.derivativeCutoff, 0.1f, 10.0f);
+    
     // Validate beat detection settings
-    beat.algorithm = std::clamp(beat.algorithm, 0, 1);
+    beat.algorithm = std::clamp(beat.algorithm, 0, 2);
     beat.falloffDefault = std::clamp(beat.falloffDefault, 0.1f, 10.0f);
     beat.timeScale = std::clamp(beat.timeScale, 1e-12f, 1e-6f);
     beat.timeInitial = std::clamp(beat.timeInitial, 0.1f, 2.0f);
@@ -59,6 +144,8 @@ bool Configuration::Validate() {
     }
     frequency.equalizerWidth = std::clamp(frequency.equalizerWidth, 0.05f, 0.5f);
     frequency.amplifier = std::clamp(frequency.amplifier, 1.0f, 11.0f);
+    frequency.windowType = std::clamp(frequency.windowType, 0, 3);
+    frequency.hopSize = std::clamp(frequency.hopSize, static_cast<size_t>(32), std::max(frequency.fftSize, static_cast<size_t>(32)));
     
     // Ensure min < max for frequency ranges
     if (frequency.minFreq >= frequency.maxFreq) {
@@ -104,7 +191,6 @@ bool Configuration::SaveToJson(const std::string& filepath) const {
         file << "  \"audio\": {\n";
         file << "    \"analysisEnabled\": " << (audio.analysisEnabled ? "true" : "false") << ",\n";
         file << "    \"captureProviderCode\": \"" << audio.captureProviderCode << "\",\n";
-        file << "    \"panSmoothing\": " << audio.panSmoothing << ",\n";
         file << "    \"panOffset\": " << audio.panOffset << "\n";
         file << "  },\n";
         
@@ -144,9 +230,22 @@ bool Configuration::SaveToJson(const std::string& filepath) const {
         // Serialize new members
         file << "    \"bands\": " << frequency.bands << ",\n";
         file << "    \"fftSize\": " << frequency.fftSize << ",\n";
+        file << "    \"hopSize\": " << frequency.hopSize << ",\n";
+        file << "    \"windowType\": " << frequency.windowType << ",\n";
         file << "    \"bandNorm\": " << frequency.bandNorm << "\n";
         file << "  },\n";
         
+        // Smoothing settings (keys are unique across sections for the flat key lookup in LoadFromJson)
+        file << "  \"smoothing\": {\n";
+        file << "    \"panMinCutoff\": " << smoothing.panMinCutoff << ",\n";
+        file << "    \"panBeta\": " << smoothing.panBeta << ",\n";
+        file << "    \"volumeMinCutoff\": " << smoothing.volumeMinCutoff << ",\n";
+        file << "    \"volumeBeta\": " << smoothing.volumeBeta << ",\n";
+        file << "    \"tempoMinCutoff\": " << smoothing.tempoMinCutoff << ",\n";
+        file << "    \"tempoBeta\": " << smoothing.tempoBeta << ",\n";
+        file << "    \"smoothingDerivativeCutoff\": " << smoothing.derivativeCutoff << "\n";
+        file << "  },\n";
+        
         // Debug settings
         file << "  \"debug\": {\n";
         file << "    \"debugEnabled\": " << (debug.debugEnabled ? "true" : "false") << ",\n";
@@ -213,9 +312,6 @@ bool Configuration::LoadFromJson(const std::string& filepath) {
         value = getValue("captureProviderCode");
         if (!value.empty()) audio.captureProviderCode = value.substr(1, value.length() - 2); // remove quotes
         
-        value = getValue("panSmoothing");
-        if (!value.empty()) audio.panSmoothing = std::stof(value);
-        
         value = getValue("panOffset");
         if (!value.empty()) audio.panOffset = std::stof(value);
         
@@ -299,9 +395,41 @@ bool Configuration::LoadFromJson(const std::string& filepath) {
         if (!value.empty()) frequency.bands = static_cast<size_t>(std::stoul(value));
         value = getValue("fftSize");
         if (!value.empty()) frequency.fftSize = static_cast<size_t>(std::stoul(value));
+        value = getValue("hopSize");
+        if (!value.empty()) frequency.hopSize = static_cast<size_t>(std::stoul(value));
+        value = getValue("windowType");
+        if (!value.empty()) frequency.windowType = std::stoi(value);
         value = getValue("bandNorm");
         if (!value.empty()) frequency.bandNorm = std::stof(value);
         
+        // Parse smoothing settings
+        value = getValue("panMinCutoff");
+        if (!value.empty()) {
+            smoothing.panMinCutoff = std::stof(value);
+        } else {
+            // Older files only had the panSmoothing EMA strength; keep "0 = off" meaningful
+            value = getValue("panSmoothing");
+            if (!value.empty() && std::stof(value) <= 0.0f) smoothing.panMinCutoff = 0.0f;
+        }
+        
+        value = getValue("panBeta");
+        if (!value.empty()) smoothing.panBeta = std::stof(value);
+        
+        value = getValue("volumeMinCutoff");
+        if (!value.empty()) smoothing.volumeMinCutoff = std::stof(value);
+        
+        value = getValue("volumeBeta");
+        if (!value.empty()) smoothing.volumeBeta = std::stof(value);
+        
+        value = getValue("tempoMinCutoff");
+        if (!value.empty()) smoothing.tempoMinCutoff = std::stof(value);
+        
+        value = getValue("tempoBeta");
+        if (!value.empty()) smoothing.tempoBeta = std::stof(value);
+        
+        value = getValue("smoothingDerivativeCutoff");
+        if (!value.empty()) smoothing.derivativeCutoff = std::stof(value);
+        
         // Parse debug settings
         value = getValue("debugEnabled");
         if (!value.empty()) debug.debugEnabled = (value == "true");
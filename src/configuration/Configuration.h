@@ -19,8 +19,10 @@ struct Configuration {
         bool analysisEnabled = false;
         std::string captureProviderCode = "off"; // provider code string, e.g. "system", "process", "off"
         // int captureProvider = -1;  // (legacy, remove after migration)
-        float panSmoothing = 0.1f;
         float panOffset = 0.0f; // User panning adjustment, range [-1, +1], default 0
+
+        bool operator==(const Audio& other) const;
+        bool operator!=(const Audio& other) const { return !(*this == other); }
     } audio;
 
     // Beat Detection Settings
@@ -41,6 +43,9 @@ struct Configuration {
         float fluxLowAlpha = DEFAULT_FLUX_LOW_ALPHA;
         float fluxLowThresholdMultiplier = DEFAULT_FLUX_LOW_THRESHOLD_MULTIPLIER;
         float fluxMin = DEFAULT_BEAT_FLUX_MIN;
+
+        bool operator==(const BeatDetection& other) const;
+        bool operator!=(const BeatDetection& other) const { return !(*this == other); }
     } beat;
 
     // Frequency Band Settings
@@ -54,9 +59,28 @@ struct Configuration {
         float amplifier = DEFAULT_AMPLIFIER;
         size_t bands = DEFAULT_NUM_BANDS;
         size_t fftSize = DEFAULT_FFT_SIZE;
+        size_t hopSize = DEFAULT_HOP_SIZE; // Samples between consecutive analysis frames (<= fftSize)
+        int windowType = DEFAULT_FFT_WINDOW; // FftWindowType: 0=Hann, 1=Hamming, 2=Blackman-Harris, 3=Flat-top
         float bandNorm = DEFAULT_BAND_NORM;
+
+        bool operator==(const FrequencyBands& other) const;
+        bool operator!=(const FrequencyBands& other) const { return !(*this == other); }
     } frequency;
 
+    // Output smoothing: One-Euro filter per signal (minCutoff in Hz, 0 = off)
+    struct Smoothing {
+        float panMinCutoff = DEFAULT_PAN_MIN_CUTOFF;
+        float panBeta = DEFAULT_PAN_BETA;
+        float volumeMinCutoff = DEFAULT_VOLUME_MIN_CUTOFF; // Also used for left/right volume
+        float volumeBeta = DEFAULT_VOLUME_BETA;
+        float tempoMinCutoff = DEFAULT_TEMPO_MIN_CUTOFF;
+        float tempoBeta = DEFAULT_TEMPO_BETA;
+        float derivativeCutoff = DEFAULT_SMOOTHING_DERIVATIVE_CUTOFF;
+
+        bool operator==(const Smoothing& other) const;
+        bool operator!=(const Smoothing& other) const { return !(*this == other); }
+    } smoothing;
+
     // Audio sample rate (Hz)
     float sample_rate = 48000.0f;
 
@@ -64,8 +88,15 @@ struct Configuration {
     struct Debug {
         bool debugEnabled = false;
         bool overlayEnabled = false;
+
+        bool operator==(const Debug& other) const;
+        bool operator!=(const Debug& other) const { return !(*this == other); }
     } debug;
 
+    // Field-by-field comparison (used to detect edits before publishing a snapshot)
+    bool operator==(const Configuration& other) const;
+    bool operator!=(const Configuration& other) const { return !(*this == other); }
+
     // Methods for persistence
     bool Save() const;
     bool Load();
@@ -13,6 +13,8 @@ namespace Listeningway {
 
 // Static configuration instance
 Configuration ConfigurationManager::m_config = {};
+ConfigSnapshot ConfigurationManager::m_published;
+std::atomic<uint64_t> ConfigurationManager::m_version{ 0 };
 
 ConfigurationManager& ConfigurationManager::Instance() {
     static ConfigurationManager instance;
@@ -42,18 +44,24 @@ bool ConfigurationManager::Save() {
 
 bool ConfigurationManager::Load() {
     bool loaded;
+    ConfigSectionMask changed;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         loaded = m_config.Load();
         ValidateProvider();
         m_config.Validate();
+        changed = PublishLocked();
+    }
+    NotifyListeners(changed);
+    // Listeners pick up analysis and beat changes; only a provider change needs the full restart
+    if (HasSection(changed, ConfigSection::CaptureProvider)) {
+        RestartAudioSystems();
     }
-    // Use the robust restart method after loading
-    RestartAudioSystems();
     return loaded;
 }
 
 void ConfigurationManager::ResetToDefaults() {
+    ConfigSectionMask changed;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_config.ResetToDefaults();
@@ -78,14 +86,23 @@ void ConfigurationManager::ResetToDefaults() {
             }
         }
         m_config.audio.analysisEnabled = activates_capture;
+        changed = PublishLocked();
+    }
+    NotifyListeners(changed);
+    // Listeners pick up analysis and beat changes; only a provider change needs the full restart
+    if (HasSection(changed, ConfigSection::CaptureProvider)) {
+        RestartAudioSystems();
     }
-    // Use the robust restart method instead of ApplyConfigToLiveSystems
-    RestartAudioSystems();
 }
 
 void ConfigurationManager::EnsureValidProvider() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    ValidateProvider();
+    ConfigSectionMask changed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ValidateProvider();
+        changed = PublishLocked();
+    }
+    NotifyListeners(changed);
 }
 
 std::vector<std::string> ConfigurationManager::EnumerateAvailableProviders() const {
@@ -159,13 +176,16 @@ void ConfigurationManager::RestartAudioSystems() {
     try {
         // Create a local copy of the configuration while holding the lock
         Configuration config_copy;
+        ConfigSectionMask changed;
         {
             std::lock_guard<std::mutex> lock(m_mutex);
             // Validate provider before restarting
             ValidateProvider();
             // Copy the configuration for use outside the lock
             config_copy = m_config;
+            changed = PublishLocked();
         }
+        NotifyListeners(changed);
         
         // Apply beat detection algorithm (this doesn't need the lock)
         g_audio_analyzer.SetBeatDetectionAlgorithm(config_copy.beat.algorithm);
@@ -194,6 +214,72 @@ Configuration ConfigurationManager::Snapshot() {
     return m_config;
 }
 
+ConfigSnapshot ConfigurationManager::Current() {
+    // Per-thread cache: the common case is one atomic load and a refcount increment
+    thread_local ConfigSnapshot cached;
+    thread_local uint64_t cached_version = 0;
+    const uint64_t version = m_version.load(std::memory_order_acquire);
+    if (!cached || version != cached_version) {
+        Instance(); // The constructor publishes the first snapshot
+        cached = std::atomic_load_explicit(&m_published, std::memory_order_acquire);
+        cached_version = version;
+    }
+    return cached;
+}
+
+uint64_t ConfigurationManager::Version() {
+    return m_version.load(std::memory_order_acquire);
+}
+
+bool ConfigurationManager::PublishIfChanged() {
+    ConfigSectionMask changed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        changed = PublishLocked();
+    }
+    NotifyListeners(changed);
+    return changed != 0;
+}
+
+ConfigSectionMask ConfigurationManager::PublishLocked() {
+    // m_published is only replaced under m_mutex, so a plain read is safe here
+    const ConfigSectionMask changed = m_published ? ChangedSections(*m_published, m_config)
+                                                  : SectionBit(ConfigSection::All);
+    if (changed == 0) {
+        return 0;
+    }
+    // Store the pointer before bumping the version so a reader that sees the new version
+    // also gets the new (or a newer) snapshot
+    std::atomic_store_explicit(&m_published, ConfigSnapshot(std::make_shared<const Configuration>(m_config)),
+                               std::memory_order_release);
+    m_version.fetch_add(1, std::memory_order_release);
+    RuntimeFlags::Store(m_config.audio.analysisEnabled, m_config.debug.debugEnabled, m_config.beat.algorithm);
+    return changed;
+}
+
+void ConfigurationManager::AddChangeListener(IConfigurationChangeListener* listener) {
+    std::lock_guard<std::mutex> lock(m_listener_mutex);
+    if (listener && std::find(m_listeners.begin(), m_listeners.end(), listener) == m_listeners.end()) {
+        m_listeners.push_back(listener);
+    }
+}
+
+void ConfigurationManager::RemoveChangeListener(IConfigurationChangeListener* listener) {
+    std::lock_guard<std::mutex> lock(m_listener_mutex);
+    m_listeners.erase(std::remove(m_listeners.begin(), m_listeners.end(), listener), m_listeners.end());
+}
+
+void ConfigurationManager::NotifyListeners(ConfigSectionMask changed) {
+    if (changed == 0) {
+        return;
+    }
+    const ConfigSnapshot config = Current();
+    std::lock_guard<std::mutex> lock(m_listener_mutex);
+    for (IConfigurationChangeListener* listener : m_listeners) {
+        listener->OnConfigurationChanged(changed, config);
+    }
+}
+
 ConfigurationManager::ConfigurationManager() {
     // Attempt to load config at startup
     bool loaded = m_config.Load();
@@ -203,11 +289,17 @@ ConfigurationManager::ConfigurationManager() {
     }
     // Ensure provider is valid and select default if needed
     ValidateProvider();
+    PublishLocked();
 }
 
 void ConfigurationManager::SetAnalysisEnabled(bool enabled) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_config.audio.analysisEnabled = enabled;
+    ConfigSectionMask changed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_config.audio.analysisEnabled = enabled;
+        changed = PublishLocked();
+    }
+    NotifyListeners(changed);
 }
 
 } // namespace Listeningway
\ No newline at end of file
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "configuration.h"
+#include "iconfiguration_change_listener.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -12,6 +16,16 @@ namespace Listeningway {
  *
  * Owns a single static Configuration instance, provides thread-safe access,
  * and handles all provider logic and persistence.
+ *
+ * The working configuration (GetConfig()) is edited on the render thread. Other threads
+ * read immutable snapshots published from it (RCU style): PublishIfChanged() swaps in a new
+ * ConfigSnapshot and bumps Version(); Current() hands out the latest snapshot without
+ * taking m_mutex or copying. Hot paths should call Current() once per packet/frame and
+ * keep that pointer for the whole pass.
+ *
+ * Every publish compares the new snapshot with the previous one section by section and
+ * notifies the registered IConfigurationChangeListeners with the mask of changed sections,
+ * so each subsystem rebuilds only what an edit actually affects.
  */
 class ConfigurationManager {
 public:
@@ -27,7 +41,39 @@ public:
     const Configuration& GetConfig() const;
 
     // Returns an immutable copy of the configuration for thread-safe use in background threads
-    static Configuration Snapshot();    // Save/load/reset (no parameters, always use default path)
+    static Configuration Snapshot();
+
+    /**
+     * @brief Latest published configuration (any thread, O(1))
+     *
+     * Lock-free in steady state: each thread keeps the snapshot it last saw and only reloads
+     * the shared pointer when Version() has moved.
+     */
+    static ConfigSnapshot Current();
+
+    /**
+     * @brief Version of the published snapshot; incremented by every published snapshot
+     */
+    static uint64_t Version();
+
+    /**
+     * @brief Publish the working configuration as a new immutable snapshot if it differs
+     * from the current one, and notify listeners of the changed sections
+     * @return True if a new snapshot was published
+     */
+    bool PublishIfChanged();
+
+    /**
+     * @brief Register a listener for section change notifications (not owned)
+     */
+    void AddChangeListener(IConfigurationChangeListener* listener);
+
+    /**
+     * @brief Unregister a listener; it is not called again once this returns
+     */
+    void RemoveChangeListener(IConfigurationChangeListener* listener);
+
+    // Save/load/reset (no parameters, always use default path)
     bool Save();
     bool Load();
     void ResetToDefaults();
@@ -54,6 +100,15 @@ private:
 
     static Configuration m_config;
     mutable std::mutex m_mutex;
+    static ConfigSnapshot m_published;             // Accessed only through std::atomic_load/store
+    static std::atomic<uint64_t> m_version;
+    std::vector<IConfigurationChangeListener*> m_listeners;
+    std::mutex m_listener_mutex;
+
+    // Publishes m_config if it changed (m_mutex held); returns the sections that changed
+    ConfigSectionMask PublishLocked();
+    // Calls the listeners (m_mutex not held)
+    void NotifyListeners(ConfigSectionMask changed);
 
     // Helper for provider logic
     void ValidateProvider();
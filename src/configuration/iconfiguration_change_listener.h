@@ -1,21 +1,63 @@
 #pragma once
-#include <string>
-#include <functional>
+#include <cstdint>
+#include <memory>
+#include "configuration.h"
+
+namespace Listeningway {
+
+// Immutable, reference-counted configuration published by ConfigurationManager
+using ConfigSnapshot = std::shared_ptr<const Configuration>;
+
+/**
+ * @brief Configuration sections tracked for change notifications (bit flags)
+ */
+enum class ConfigSection : uint32_t {
+    None             = 0,
+    FrequencyMapping = 1 << 0, // bands, fftSize, hopSize, windowType, min/maxFreq, logScale, sample_rate
+    Equalizer        = 1 << 1, // equalizer bands/width, logStrength, bandNorm, amplifier
+    BeatParams       = 1 << 2, // beat detector tunables (everything in beat except algorithm)
+    BeatAlgorithm    = 1 << 3, // beat.algorithm
+    CaptureProvider  = 1 << 4, // audio.captureProviderCode, audio.analysisEnabled
+    Spatialization   = 1 << 5, // audio.panOffset
+    Debug            = 1 << 6, // debug.*
+    Smoothing        = 1 << 7, // smoothing.* (output filters)
+    All              = (1 << 8) - 1
+};
+
+using ConfigSectionMask = uint32_t;
+
+constexpr ConfigSectionMask SectionBit(ConfigSection section) {
+    return static_cast<ConfigSectionMask>(section);
+}
+
+constexpr bool HasSection(ConfigSectionMask mask, ConfigSection section) {
+    return (mask & SectionBit(section)) != 0;
+}
+
+/**
+ * @brief Sections that differ between two configurations
+ */
+ConfigSectionMask ChangedSections(const Configuration& before, const Configuration& after);
+
+} // namespace Listeningway
 
 /**
  * @brief Interface for objects that want to be notified of configuration changes
+ *
+ * Listeners are called on the thread that published the change (normally the render
+ * thread, once per overlay frame at most), after the new snapshot is already visible
+ * through ConfigurationManager::Current(). Implementations should only record what is
+ * dirty and do the rebuild on their own thread.
  */
 class IConfigurationChangeListener {
 public:
     virtual ~IConfigurationChangeListener() = default;
-    
+
     /**
-     * @brief Called when a configuration setting has changed
-     * @param settingName The name of the setting that changed
-     * @param oldValue The previous value (as string for simplicity)
-     * @param newValue The new value (as string for simplicity)
+     * @brief Called when a new configuration snapshot has been published
+     * @param changed Mask of ConfigSection bits that differ from the previous snapshot
+     * @param config The newly published snapshot
      */
-    virtual void OnConfigurationChanged(const std::string& settingName, 
-                                      const std::string& oldValue, 
-                                      const std::string& newValue) = 0;
+    virtual void OnConfigurationChanged(Listeningway::ConfigSectionMask changed,
+                                        const Listeningway::ConfigSnapshot& config) = 0;
 };
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 
 // Enums for Magic Numbers - replacing hardcoded constants with named values
 enum class AudioFormat : int {
@@ -19,7 +20,15 @@ enum class EqualizerBand : int {
 
 enum class BeatDetectionAlgorithm : int {
     SimpleEnergy = 0,
-    SpectralFluxAuto = 1
+    SpectralFluxAuto = 1,
+    PhaseLocked = 2
+};
+
+enum class FftWindowType : int {
+    Hann = 0,
+    Hamming = 1,
+    BlackmanHarris = 2,
+    FlatTop = 3
 };
 
 enum class AudioCaptureProvider : int {
@@ -30,6 +39,8 @@ enum class AudioCaptureProvider : int {
 // Audio Analysis
 constexpr size_t DEFAULT_NUM_BANDS = 32;
 constexpr size_t DEFAULT_FFT_SIZE = 512;
+constexpr size_t DEFAULT_HOP_SIZE = 512;
+constexpr int DEFAULT_FFT_WINDOW = 0; // FftWindowType::Hann
 constexpr float DEFAULT_FLUX_ALPHA = 0.1f;
 constexpr float DEFAULT_FLUX_THRESHOLD_MULTIPLIER = 1.5f;
 
@@ -77,6 +88,17 @@ constexpr float DEFAULT_PAN_SIGNIFICANT_THRESHOLD = 0.05f; // Threshold for "sig
 constexpr float DEFAULT_PAN_SMOOTHING = 0.1f; // Default: no smoothing to preserve current behavior
 constexpr float DEFAULT_AMPLIFIER = 1.0f;
 constexpr float DEFAULT_PAN_OFFSET = 0.0f;
+// Output smoothing (One-Euro filter per signal): the cutoff starts at MinCutoff (Hz) for a
+// steady signal and rises by Beta per unit/s of signal speed. MinCutoff 0 disables the filter.
+constexpr float DEFAULT_PAN_MIN_CUTOFF = 1.5f;
+constexpr float DEFAULT_PAN_BETA = 1.0f;
+constexpr float DEFAULT_VOLUME_MIN_CUTOFF = 3.0f;
+constexpr float DEFAULT_VOLUME_BETA = 1.0f;
+constexpr float DEFAULT_TEMPO_MIN_CUTOFF = 0.2f;
+constexpr float DEFAULT_TEMPO_BETA = 0.01f;         // Tempo speed is in BPM/s
+constexpr float DEFAULT_SMOOTHING_DERIVATIVE_CUTOFF = 1.0f;
+// Capture-to-analysis sample queue length, in seconds of device audio
+constexpr float DEFAULT_SAMPLE_RING_SECONDS = 0.5f;
 
 // UI/Overlay tunables
 constexpr float DEFAULT_CAPTURE_STALE_TIMEOUT = 1.5f;
@@ -133,3 +155,7 @@ constexpr float OVERLAY_FLUX_THRESH_STEP = 0.01f;
 constexpr float OVERLAY_PAN_OFFSET_MIN = -1.0f;
 constexpr float OVERLAY_PAN_OFFSET_MAX = 1.0f;
 constexpr float OVERLAY_PAN_OFFSET_STEP = 0.01f;
+constexpr float OVERLAY_SMOOTHING_CUTOFF_MIN = 0.0f;
+constexpr float OVERLAY_SMOOTHING_CUTOFF_MAX = 20.0f;
+constexpr float OVERLAY_SMOOTHING_BETA_MIN = 0.0f;
+constexpr float OVERLAY_SMOOTHING_BETA_MAX = 5.0f;
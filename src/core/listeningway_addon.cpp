@@ -39,24 +39,43 @@ static float g_last_volume = 0.0f;
 static std::chrono::steady_clock::time_point g_start_time = std::chrono::steady_clock::now();
 std::atomic_bool g_switching_provider = false;
 
+// Latest analysis frame, copied into a buffer owned by the calling thread (runtimes may
+// present on different threads). Valid until the same thread calls this again; the copy
+// reuses the buffer's capacity, so it does not allocate once the band count is stable.
+static const AudioAnalysisData& LatestFrame() {
+    thread_local AudioAnalysisData frame;
+    g_audio_analyzer.CopyLatestFrame(frame);
+    return frame;
+}
+
 // Updates all Listeningway_* uniforms in loaded effects
 static void UpdateShaderUniforms(reshade::api::effect_runtime* runtime) {    float volume_to_set;
     std::vector<float> freq_bands_to_set;
     float beat_to_set;
     float volume_left, volume_right, audio_pan, audio_format;
+    float beat_phase, time_to_next_beat, beat_period;
+    std::chrono::steady_clock::time_point published_at;
     float amplifier = 1.0f;
+    uint64_t sequence;
     {
-        LOCK_AUDIO_DATA();
-        volume_to_set = g_audio_data.volume;
-        freq_bands_to_set = g_audio_data.freq_bands;
-        beat_to_set = g_audio_data.beat;
-        volume_left = g_audio_data.volume_left;
-        volume_right = g_audio_data.volume_right;
-        audio_pan = g_audio_data.audio_pan;
-        audio_format = g_audio_data.audio_format;    }
-    // Get amplifier from config - thread-safe snapshot
-    const auto config = ConfigurationManager::Snapshot();
-    amplifier = config.frequency.amplifier;
+        // Latest complete frame from the analyzer; never stalls behind an FFT
+        const AudioAnalysisData& frame = LatestFrame();
+        volume_to_set = frame.volume;
+        freq_bands_to_set = frame.freq_bands;
+        beat_to_set = frame.beat;
+        volume_left = frame.volume_left;
+        volume_right = frame.volume_right;
+        audio_pan = frame.audio_pan;
+        audio_format = frame.audio_format;
+        beat_phase = frame.beat_phase;
+        time_to_next_beat = frame.time_to_next_beat;
+        beat_period = frame.tempo_detected ? frame.beat_period : 0.0f;
+        published_at = frame.published_at;
+        sequence = frame.sequence;    }
+    // Read the version before the snapshot: a publish in between only causes one extra upload
+    const uint64_t config_version = ConfigurationManager::Version();
+    // Get amplifier from the published config snapshot (lock-free, no copy)
+    amplifier = ConfigurationManager::Current()->frequency.amplifier;
     // Apply amplifier to all relevant values
     volume_to_set *= amplifier;
     beat_to_set *= amplifier;
@@ -70,9 +89,34 @@ static void UpdateShaderUniforms(reshade::api::effect_runtime* runtime) {    flo
     float phase_60hz = std::fmod(time_seconds * 60.0f, 1.0f);
     float phase_120hz = std::fmod(time_seconds * 120.0f, 1.0f);
     float total_phases_60hz = time_seconds * 60.0f;
-    float total_phases_120hz = time_seconds * 120.0f;    g_uniform_manager.update_uniforms(runtime, volume_to_set, freq_bands_to_set, beat_to_set,
-        time_seconds, phase_60hz, phase_120hz, total_phases_60hz, total_phases_120hz,
-        volume_left, volume_right, audio_pan, audio_format);
+    float total_phases_120hz = time_seconds * 120.0f;
+    // The analyzer publishes at its hop rate; advance the beat phase by the time since that
+    // frame was published so it moves every rendered frame instead of in hop-sized steps
+    if (beat_period > 0.0f) {
+        const float since_publish = std::max(0.0f, std::chrono::duration<float>(now - published_at).count());
+        beat_phase = std::fmod(beat_phase + since_publish / beat_period, 1.0f);
+        time_to_next_beat = (1.0f - beat_phase) * beat_period;
+    }
+    
+    UniformFrame uniforms;
+    uniforms.sequence = sequence;
+    uniforms.config_version = config_version;
+    uniforms.volume = volume_to_set;
+    uniforms.freq_bands = freq_bands_to_set.data();
+    uniforms.freq_band_count = static_cast<uint32_t>(freq_bands_to_set.size());
+    uniforms.beat = beat_to_set;
+    uniforms.time_seconds = time_seconds;
+    uniforms.phase_60hz = phase_60hz;
+    uniforms.phase_120hz = phase_120hz;
+    uniforms.total_phases_60hz = total_phases_60hz;
+    uniforms.total_phases_120hz = total_phases_120hz;
+    uniforms.volume_left = volume_left;
+    uniforms.volume_right = volume_right;
+    uniforms.audio_pan = audio_pan;
+    uniforms.audio_format = audio_format;
+    uniforms.beat_phase = beat_phase;
+    uniforms.time_to_next_beat = time_to_next_beat;
+    g_uniform_manager.update_uniforms(runtime, uniforms);
 }
 
 /**
@@ -80,19 +124,25 @@ static void UpdateShaderUniforms(reshade::api::effect_runtime* runtime) {    flo
  * @param runtime The ReShade effect runtime.
  */
 static void OnReloadedEffects(reshade::api::effect_runtime* runtime) {
-    // No longer needed: uniform handles are not cached
+    // Uniform handles change with every reload, so the binding table is rebuilt here and
+    // the per-frame update only walks the bound Listeningway uniforms
+    g_uniform_manager.rebuild_bindings(runtime);
+}
+
+/**
+ * @brief Forgets the uniform bindings of an effect runtime that is being destroyed.
+ * @param runtime The ReShade effect runtime.
+ */
+static void OnDestroyEffectRuntime(reshade::api::effect_runtime* runtime) {
+    g_uniform_manager.remove_runtime(runtime);
 }
 
 /**
  * @brief Checks if new audio values have been captured in the last 3 seconds.
  * If not, attempts to restart the audio capture thread.
+ * @param current_volume Volume of the latest analysis frame.
  */
-static void MaybeRestartAudioCaptureIfStale() {
-    float current_volume;
-    {
-        LOCK_AUDIO_DATA();
-        current_volume = g_audio_data.volume;
-    }
+static void MaybeRestartAudioCaptureIfStale(float current_volume) {
     auto now = std::chrono::steady_clock::now();
     if (current_volume != g_last_volume) {
         g_last_audio_update = now;
@@ -111,8 +161,10 @@ static void MaybeRestartAudioCaptureIfStale() {
  */
 static void OverlayCallback(reshade::api::effect_runtime*) {
     try {
-        MaybeRestartAudioCaptureIfStale();
-        DrawListeningwayDebugOverlay(g_audio_data);
+        // One copy of the latest frame serves both the stale check and the overlay
+        const AudioAnalysisData& frame = LatestFrame();
+        MaybeRestartAudioCaptureIfStale(frame.volume);
+        DrawListeningwayDebugOverlay(frame);
     } catch (const std::exception& ex) {
         LOG_ERROR(std::string("[Overlay] Exception: ") + ex.what());
     } catch (...) {
@@ -146,6 +198,8 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
                         (reshade::addon_event_traits<reshade::addon_event::reshade_begin_effects>::decl)UpdateShaderUniforms);
                     reshade::register_event<reshade::addon_event::reshade_reloaded_effects>(
                         (reshade::addon_event_traits<reshade::addon_event::reshade_reloaded_effects>::decl)OnReloadedEffects);
+                    reshade::register_event<reshade::addon_event::destroy_effect_runtime>(
+                        (reshade::addon_event_traits<reshade::addon_event::destroy_effect_runtime>::decl)OnDestroyEffectRuntime);
                       // Initialize and start the audio analyzer with the configured algorithm
                     const auto config = ConfigurationManager::Snapshot();
                     g_audio_analyzer.SetBeatDetectionAlgorithm(config.beat.algorithm);
@@ -166,6 +220,8 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
                         (reshade::addon_event_traits<reshade::addon_event::reshade_begin_effects>::decl)UpdateShaderUniforms);
                     reshade::unregister_event<reshade::addon_event::reshade_reloaded_effects>(
                         (reshade::addon_event_traits<reshade::addon_event::reshade_reloaded_effects>::decl)OnReloadedEffects);
+                    reshade::unregister_event<reshade::addon_event::destroy_effect_runtime>(
+                        (reshade::addon_event_traits<reshade::addon_event::destroy_effect_runtime>::decl)OnDestroyEffectRuntime);
                     
                     // Stop the audio analyzer
                     g_audio_analyzer.Stop();
@@ -197,7 +253,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
  *
  * @section extend_sec How to Extend
  * - Add new analysis features in audio_analysis.*
- * - Add new uniforms in uniform_manager.* and update logic
+ * - Add new uniforms as one entry in uniform_registry.h (plus a UniformFrame field)
  * - Add new overlay elements in overlay.*
  * - Use logging for debugging and diagnostics
  *
@@ -12,7 +12,6 @@
 #include "audio_format_utils.h"
 #include "settings.h"
 #include "logging.h"
-#include "thread_safety_manager.h"
 #include "audio/capture/audio_capture.h"
 #include "configuration/configuration_manager.h"
 using Listeningway::ConfigurationManager;
@@ -24,7 +23,6 @@ using Listeningway::ConfigurationManager;
 #include <algorithm> // For std::clamp
 
 extern std::atomic_bool g_audio_analysis_enabled;
-extern bool g_listeningway_debug_enabled;
 
 // External declarations for global variables used in overlay
 extern std::atomic_bool g_switching_provider;
@@ -99,8 +97,8 @@ static void DrawToggles() {
         ImGui::EndCombo();
     }
 
-    // Use the global debug flag directly, then synchronize with configManager through SetDebugEnabled
-    bool debug_enabled = g_listeningway_debug_enabled;
+    // Read the runtime flag; SetDebugEnabled updates the configuration and republishes it
+    bool debug_enabled = Listeningway::RuntimeFlags::DebugEnabled();
     if (ImGui::Checkbox("Enable Debug Logging", &debug_enabled)) {
         SetDebugEnabled(debug_enabled);
         LOG_DEBUG(std::string("[Overlay] Debug Logging toggled ") + (debug_enabled ? "ON" : "OFF"));
@@ -109,7 +107,7 @@ static void DrawToggles() {
 
 // Helper: Draw log file info
 static void DrawLogInfo() {
-    if (g_listeningway_debug_enabled) {
+    if (Listeningway::RuntimeFlags::DebugEnabled()) {
         ImGui::Text("Log file: ");
         ImGui::SameLine();
         std::string logPath = GetLogFilePath();
@@ -117,6 +115,11 @@ static void DrawLogInfo() {
             ShellExecuteA(nullptr, "open", logPath.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
         }
         ImGui::Text("(Click to open log file)");
+        const SampleRing::Stats ring = GetAudioCaptureRingStats();
+        ImGui::Text("Capture queue: %llu overflows (%llu samples dropped), %llu underruns",
+                    static_cast<unsigned long long>(ring.overflows),
+                    static_cast<unsigned long long>(ring.dropped_samples),
+                    static_cast<unsigned long long>(ring.underruns));
     }
 }
 
@@ -225,24 +228,28 @@ static void DrawBeatDetectionAlgorithm(const AudioAnalysisData& data) {
     ImGui::Text("Beat Detection Algorithm:");
     
     // Create a combo box for algorithm selection
-    const char* algorithms[] = { "Simple Energy (Original)", "Spectral Flux + Autocorrelation (Advanced)" };    int algorithm = config.beat.algorithm;    if (ImGui::Combo("Algorithm", &algorithm, algorithms, IM_ARRAYSIZE(algorithms))) {
+    const char* algorithms[] = { "Simple Energy (Original)", "Spectral Flux + Autocorrelation (Advanced)",
+                                 "Phase-Locked Beat Tracker (Predictive)" };
+    int algorithm = config.beat.algorithm;
+    if (ImGui::Combo("Algorithm", &algorithm, algorithms, IM_ARRAYSIZE(algorithms))) {
         config.beat.algorithm = algorithm;
-        LOG_DEBUG(std::string("[Overlay] Beat Detection Algorithm changed to ") + 
-                 (algorithm == 0 ? "Simple Energy" : "Spectral Flux + Autocorrelation"));
-        // Update the audio analyzer with the new algorithm
-        g_audio_analyzer.SetBeatDetectionAlgorithm(algorithm);
+        LOG_DEBUG(std::string("[Overlay] Beat Detection Algorithm changed to ") + algorithms[algorithm]);
+        // The analyzer swaps detectors when this change is published at the end of the frame
     }
     
     if (ImGui::IsItemHovered(-1)) {
         if (config.beat.algorithm == 0) {
             ImGui::SetTooltip("Simple Energy: Works well with strong bass beats");
-        } else {
+        } else if (config.beat.algorithm == 1) {
             ImGui::SetTooltip("Advanced: Better for complex rhythms and various music genres");
+        } else {
+            ImGui::SetTooltip("Predictive: Locks onto the tempo and fires beats on time\nSmooth beat phase and time-to-next-beat for shaders");
         }
     }
     
-    // Show advanced settings for the Spectral Flux + Autocorrelation algorithm
-    if (config.beat.algorithm == 1) {
+    // Show advanced settings for the Spectral Flux + Autocorrelation algorithm (the
+    // phase-locked tracker uses it for its tempo estimate)
+    if (config.beat.algorithm != 0) {
         // Create a collapsing section for advanced parameters
         if (ImGui::CollapsingHeader("Advanced Algorithm Parameters", ImGuiTreeNodeFlags_DefaultOpen)) {
             // Spectral Flux threshold adjustment
@@ -283,13 +290,16 @@ static void DrawBeatDetectionAlgorithm(const AudioAnalysisData& data) {
             ImGui::SameLine();
             ImGui::Text("Octave Error Weight");
             if (ImGui::IsItemHovered(-1)) {
-                ImGui::SetTooltip("Higher values favor base tempo vs half/double detection");
+                ImGui::SetTooltip("Higher values switch to half/double tempo more readily");
             }
             
             // Display current tempo info directly (no tree node)
             if (data.tempo_detected) {
                 ImGui::Text("Current Tempo: %.1f BPM (Confidence: %.2f)", data.tempo_bpm, data.tempo_confidence);
                 ImGui::Text("Beat Phase: %.2f", data.beat_phase);
+                if (config.beat.algorithm == 2) {
+                    ImGui::Text("Next Beat In: %.3f s", data.time_to_next_beat);
+                }
             } else {
                 ImGui::Text("No tempo detected yet");
             }
@@ -429,6 +439,48 @@ static void DrawFrequencyBoostSettings() {
     }
 }
 
+// Output Smoothing section: One-Euro cutoff and speed response per signal
+static void DrawOutputSmoothingSettings() {
+    auto& config = g_configManager.GetConfig();
+    
+    if (ImGui::CollapsingHeader("Output Smoothing")) {
+        ImGui::PushID("Smoothing");
+        struct SignalRow {
+            const char* label;
+            float* min_cutoff;
+            float* beta;
+        };
+        const SignalRow rows[] = {
+            { "Volume", &config.smoothing.volumeMinCutoff, &config.smoothing.volumeBeta },
+            { "Pan", &config.smoothing.panMinCutoff, &config.smoothing.panBeta },
+            { "Tempo", &config.smoothing.tempoMinCutoff, &config.smoothing.tempoBeta },
+        };
+        for (const SignalRow& row : rows) {
+            ImGui::PushID(row.label);
+            float min_cutoff = *row.min_cutoff;
+            if (ImGui::SliderFloat("##MinCutoff", &min_cutoff, OVERLAY_SMOOTHING_CUTOFF_MIN, OVERLAY_SMOOTHING_CUTOFF_MAX, "%.2f Hz")) {
+                *row.min_cutoff = min_cutoff;
+            }
+            ImGui::SameLine();
+            ImGui::Text("%s Cutoff", row.label);
+            if (ImGui::IsItemHovered(-1)) {
+                ImGui::SetTooltip("Smoothing while the value is steady\nLower = steadier, 0 = smoothing off");
+            }
+            float beta = *row.beta;
+            if (ImGui::SliderFloat("##Beta", &beta, OVERLAY_SMOOTHING_BETA_MIN, OVERLAY_SMOOTHING_BETA_MAX, "%.3f")) {
+                *row.beta = beta;
+            }
+            ImGui::SameLine();
+            ImGui::Text("%s Response", row.label);
+            if (ImGui::IsItemHovered(-1)) {
+                ImGui::SetTooltip("How much fast changes open up the filter\nHigher = less lag on quick moves");
+            }
+            ImGui::PopID();
+        }
+        ImGui::PopID();
+    }
+}
+
 // Helper: Draw spatialization info (left/right volume and pan)
 static void DrawSpatialization(const AudioAnalysisData& data) {
     // Align all progress bars to the same X position
@@ -613,20 +665,8 @@ static void DrawVolumeSpatializationBeat(const AudioAnalysisData& data) {
     ImGui::SameLine(bar_start_x);
     AudioFormat format = AudioFormatUtils::IntToFormat(static_cast<int>(data.audio_format));
     const char* format_name = AudioFormatUtils::FormatToString(format);
-    ImGui::Text("%s (%.0f)", format_name, data.audio_format);// Pan Smoothing
-    ImGui::AlignTextToFramePadding();
-    ImGui::Text("Pan Smooth:");
-    ImGui::SameLine(bar_start_x);
-    float pan_smoothing = config.audio.panSmoothing;
-    ImGui::PushItemWidth(bar_width);
-    if (ImGui::SliderFloat("##PanSmoothing", &pan_smoothing, 0.0f, 1.0f, "%.2f")) {
-        config.audio.panSmoothing = pan_smoothing;
-    }
-    ImGui::PopItemWidth();
-    if (ImGui::IsItemHovered(-1)) {
-        ImGui::SetTooltip("Reduces pan jitter. 0.0 = no smoothing (current behavior), higher values = more smoothing");
-    }
-    // Pan Offset slider (full width, under Pan Smoothing)
+    ImGui::Text("%s (%.0f)", format_name, data.audio_format);
+    // Pan Offset slider (full width, under Format)
     float pan_offset = config.audio.panOffset;
     ImGui::AlignTextToFramePadding();
     ImGui::Text("Pan Offset:");
@@ -639,7 +679,7 @@ static void DrawVolumeSpatializationBeat(const AudioAnalysisData& data) {
     if (ImGui::IsItemHovered(-1)) {
         ImGui::SetTooltip("Adjusts the detected pan left/right. -1 = full left, 0 = no offset, +1 = full right. Use to compensate for system or room bias.");
     }
-    // Amplifier slider (full width, aligned under Pan Smooth, with label)
+    // Amplifier slider (full width, aligned under Pan Offset, with label)
     float amplifier = config.frequency.amplifier;
     bool amp_is_spinal = amplifier > 10.0f;
     if (amp_is_spinal) {
@@ -675,13 +715,14 @@ static void DrawVolumeSpatializationBeat(const AudioAnalysisData& data) {
 // Shows volume, beat, and frequency bands in real time.
 void DrawListeningwayDebugOverlay(const AudioAnalysisData& data) {
     try {
+        // data is a published analysis frame owned by the render thread; no lock needed
         ImGui::GetIO().UserData = (void*)&data;
-        LOCK_AUDIO_DATA();
         DrawToggles();
         DrawLogInfo();
         ImGui::Separator();
         DrawWebsite();
         ImGui::Separator();        DrawVolumeSpatializationBeat(data);
+        DrawOutputSmoothingSettings();
         ImGui::Separator();
         DrawFrequencyBands(data);
         ImGui::Separator();
@@ -737,6 +778,15 @@ void DrawListeningwayDebugOverlay(const AudioAnalysisData& data) {
             }
 
         }
+        
+        const char* windows[] = { "Hann", "Hamming", "Blackman-Harris", "Flat-top" };
+        int window_type = config.frequency.windowType;
+        if (ImGui::Combo("FFT Window", &window_type, windows, IM_ARRAYSIZE(windows))) {
+            config.frequency.windowType = window_type;
+        }
+        if (ImGui::IsItemHovered(-1)) {
+            ImGui::SetTooltip("Hann: balanced default\nHamming: narrower peaks, more leakage\nBlackman-Harris: lowest leakage, softer transients\nFlat-top: accurate band levels, widest peaks");
+        }
 
         
         // 5-band equalizer settings
@@ -817,6 +867,10 @@ void DrawListeningwayDebugOverlay(const AudioAnalysisData& data) {
         ImGui::Columns(1);
         
         ImGui::Separator();
+        
+        // The widgets above edit the working config in place; hand any edits to the
+        // audio threads as one new snapshot per overlay frame
+        g_configManager.PublishIfChanged();
     } catch (const std::exception& ex) {
         LOG_ERROR(std::string("[Overlay] Exception in DrawListeningwayDebugOverlay: ") + ex.what());
     } catch (...) {
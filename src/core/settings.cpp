@@ -13,7 +13,6 @@
 ListeningwaySettings g_settings = {};
 
 std::atomic_bool g_audio_analysis_enabled = DEFAULT_AUDIO_ANALYSIS_ENABLED;
-bool g_listeningway_debug_enabled = DEFAULT_DEBUG_ENABLED;
 
 /**
  * @brief Retrieves the path to the settings .ini file.
@@ -50,8 +49,11 @@ static std::mutex g_settings_mutex;
 void LoadSettings() {
     std::lock_guard<std::mutex> lock(g_settings_mutex);
     std::string ini = GetSettingsPath();
-    g_audio_analysis_enabled = GetPrivateProfileIntA("General", "AudioAnalysisEnabled", 1, ini.c_str()) != 0;    g_listeningway_debug_enabled = GetPrivateProfileIntA("General", "DebugEnabled", 0, ini.c_str()) != 0;
-    Listeningway::ConfigurationManager::Instance().GetConfig().debug.debugEnabled = g_listeningway_debug_enabled; // Keep both in sync
+    g_audio_analysis_enabled = GetPrivateProfileIntA("General", "AudioAnalysisEnabled", 1, ini.c_str()) != 0;
+    // Publishing updates RuntimeFlags::DebugEnabled(), which gates LOG_DEBUG
+    Listeningway::ConfigurationManager::Instance().GetConfig().debug.debugEnabled =
+        GetPrivateProfileIntA("General", "DebugEnabled", 0, ini.c_str()) != 0;
+    Listeningway::ConfigurationManager::Instance().PublishIfChanged();
 }
 
 /**
@@ -61,7 +63,7 @@ void SaveSettings() {
     std::lock_guard<std::mutex> lock(g_settings_mutex);
     std::string ini = GetSettingsPath();
     WritePrivateProfileStringA("General", "AudioAnalysisEnabled", g_audio_analysis_enabled ? "1" : "0", ini.c_str());
-    WritePrivateProfileStringA("General", "DebugEnabled", g_listeningway_debug_enabled ? "1" : "0", ini.c_str());
+    WritePrivateProfileStringA("General", "DebugEnabled", Listeningway::RuntimeFlags::DebugEnabled() ? "1" : "0", ini.c_str());
 }
 
 /**
@@ -92,11 +94,11 @@ void SetAudioAnalysisEnabled(bool enabled) {
     if (enabled) {
         // Start the audio analyzer with the current algorithm
         extern AudioAnalyzer g_audio_analyzer;
-        const auto config = Listeningway::ConfigurationManager::Snapshot(); // Thread-safe snapshot
-        g_audio_analyzer.SetBeatDetectionAlgorithm(config.beat.algorithm);
+        const int algorithm = Listeningway::RuntimeFlags::BeatAlgorithm();
+        g_audio_analyzer.SetBeatDetectionAlgorithm(algorithm);
         g_audio_analyzer.Start();
         LOG_DEBUG("[Settings] Audio analyzer started with algorithm: " + 
-                 std::to_string(config.beat.algorithm));
+                 std::to_string(algorithm));
     } else {
         // Stop the audio analyzer
         extern AudioAnalyzer g_audio_analyzer;
@@ -112,8 +114,7 @@ void SetAudioAnalysisEnabled(bool enabled) {
  * @return True if debug mode is enabled, false otherwise.
  */
 bool GetDebugEnabled() {
-    std::lock_guard<std::mutex> lock(g_settings_mutex);
-    return g_listeningway_debug_enabled;
+    return Listeningway::RuntimeFlags::DebugEnabled();
 }
 
 /**
@@ -122,8 +123,10 @@ bool GetDebugEnabled() {
  */
 void SetDebugEnabled(bool enabled) {
     {
-        std::lock_guard<std::mutex> lock(g_settings_mutex);        g_listeningway_debug_enabled = enabled;
-        Listeningway::ConfigurationManager::Instance().GetConfig().debug.debugEnabled = enabled; // Ensure both variables are in sync
+        std::lock_guard<std::mutex> lock(g_settings_mutex);
+        // Publishing updates RuntimeFlags::DebugEnabled(), which gates LOG_DEBUG
+        Listeningway::ConfigurationManager::Instance().GetConfig().debug.debugEnabled = enabled;
+        Listeningway::ConfigurationManager::Instance().PublishIfChanged();
     }
     SaveSettings();
 }
@@ -187,8 +190,7 @@ void SaveAllTunables() {
       // Update beat detector with current settings if audio analysis is enabled
     if (g_audio_analysis_enabled) {
         extern AudioAnalyzer g_audio_analyzer;
-        const auto config = Listeningway::ConfigurationManager::Snapshot(); // Thread-safe snapshot
-        g_audio_analyzer.SetBeatDetectionAlgorithm(config.beat.algorithm);
+        g_audio_analyzer.SetBeatDetectionAlgorithm(Listeningway::RuntimeFlags::BeatAlgorithm());
     }
     
     // Save configuration to JSON file
@@ -209,8 +211,7 @@ void ResetAllTunablesToDefaults() {
       // Update beat detector with default algorithm if audio analysis is enabled
     if (g_audio_analysis_enabled) {
         extern AudioAnalyzer g_audio_analyzer;
-        const auto config = Listeningway::ConfigurationManager::Snapshot(); // Thread-safe snapshot
-        g_audio_analyzer.SetBeatDetectionAlgorithm(config.beat.algorithm);
+        g_audio_analyzer.SetBeatDetectionAlgorithm(Listeningway::RuntimeFlags::BeatAlgorithm());
     }
     
     LOG_DEBUG("[Settings] Reset all tunables to defaults using ConfigurationManager");
@@ -25,7 +25,7 @@ struct ListeningwaySettings {
     float volume_norm = DEFAULT_AMPLIFIER;
     float band_norm = DEFAULT_BAND_NORM;
     float capture_stale_timeout = DEFAULT_CAPTURE_STALE_TIMEOUT;    
-    int beat_detection_algorithm = DEFAULT_BEAT_DETECTION_ALGORITHM; // 0 = SimpleEnergy, 1 = SpectralFluxAuto
+    int beat_detection_algorithm = DEFAULT_BEAT_DETECTION_ALGORITHM; // 0 = SimpleEnergy, 1 = SpectralFluxAuto, 2 = PhaseLocked
     
     // Spectral flux autocorrelation settings
     float spectral_flux_threshold = DEFAULT_SPECTRAL_FLUX_THRESHOLD;
@@ -3,43 +3,92 @@
 // @brief Uniform management implementation for Listeningway ReShade addon
 // ---------------------------------------------
 #include "uniform_manager.h"
+#include <algorithm>
+#include <cstring>
 #include <string_view>
+#include "logging.h"
 #include "settings.h" // Include settings header for g_settings
 
-void UniformManager::update_uniforms(reshade::api::effect_runtime* runtime, float volume, const std::vector<float>& freq_bands, float beat,
-    float time_seconds, float phase_60hz, float phase_120hz, float total_phases_60hz, float total_phases_120hz,
-    float volume_left, float volume_right, float audio_pan, float audio_format) {
-    // Only update uniforms with the correct annotation (source = ...)
+void UniformManager::rebuild_bindings(reshade::api::effect_runtime* runtime) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bind_runtime(runtime);
+}
+
+void UniformManager::remove_runtime(reshade::api::effect_runtime* runtime) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    runtimes_.erase(runtime);
+}
+
+UniformManager::RuntimeBindings& UniformManager::bind_runtime(reshade::api::effect_runtime* runtime) {
+    RuntimeBindings& state = runtimes_[runtime];
+    state.bindings.clear();
+    // Reloaded effects start from their default values, so everything is uploaded again
+    for (std::vector<float>& values : state.last_values) {
+        values.clear();
+    }
+    state.uploaded = false;
+    // Annotation lookup and string matching happen only here, once per effect reload
     runtime->enumerate_uniform_variables(nullptr, [&](reshade::api::effect_runtime*, reshade::api::effect_uniform_variable var_handle) {
         char source[64] = "";
-        if (runtime->get_annotation_string_from_uniform_variable(var_handle, "source", source)) {
-            if (strcmp(source, "listeningway_volume") == 0) {
-                runtime->set_uniform_value_float(var_handle, &volume, 1);
-            } else if (strcmp(source, "listeningway_freqbands") == 0) {
-                if (!freq_bands.empty()) {
-                    runtime->set_uniform_value_float(var_handle, freq_bands.data(), static_cast<uint32_t>(freq_bands.size()));
-                }
-            } else if (strcmp(source, "listeningway_beat") == 0) {
-                runtime->set_uniform_value_float(var_handle, &beat, 1);
-            } else if (strcmp(source, "listeningway_timeseconds") == 0) {
-                runtime->set_uniform_value_float(var_handle, &time_seconds, 1);
-            } else if (strcmp(source, "listeningway_timephase60hz") == 0) {
-                runtime->set_uniform_value_float(var_handle, &phase_60hz, 1);
-            } else if (strcmp(source, "listeningway_timephase120hz") == 0) {
-                runtime->set_uniform_value_float(var_handle, &phase_120hz, 1);
-            } else if (strcmp(source, "listeningway_totalphases60hz") == 0) {
-                runtime->set_uniform_value_float(var_handle, &total_phases_60hz, 1);
-            } else if (strcmp(source, "listeningway_totalphases120hz") == 0) {
-                runtime->set_uniform_value_float(var_handle, &total_phases_120hz, 1);
-            } else if (strcmp(source, "listeningway_volumeleft") == 0) {
-                runtime->set_uniform_value_float(var_handle, &volume_left, 1); 
-            } else if (strcmp(source, "listeningway_volumeright") == 0) {
-                runtime->set_uniform_value_float(var_handle, &volume_right, 1);
-            } else if (strcmp(source, "listeningway_audiopan") == 0) {
-                runtime->set_uniform_value_float(var_handle, &audio_pan, 1);
-            } else if (strcmp(source, "listeningway_audioformat") == 0) {
-                runtime->set_uniform_value_float(var_handle, &audio_format, 1);
-            }
+        UniformSourceId id;
+        if (!runtime->get_annotation_string_from_uniform_variable(var_handle, "source", source) ||
+            !UniformRegistry::Find(source, id)) {
+            return;
         }
+        reshade::api::format base_type = reshade::api::format::unknown;
+        uint32_t rows = 0, columns = 0, array_length = 0;
+        runtime->get_uniform_variable_type(var_handle, &base_type, &rows, &columns, &array_length);
+        const uint32_t element_count = std::max(array_length, 1u) * std::max(rows, 1u) * std::max(columns, 1u);
+        state.bindings.push_back({ var_handle, id, element_count });
     });
+    LOG_DEBUG("[UniformManager] Bound " + std::to_string(state.bindings.size()) + " Listeningway uniform(s)");
+    return state;
+}
+
+void UniformManager::update_uniforms(reshade::api::effect_runtime* runtime, const UniformFrame& frame) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The table is normally built on reshade_reloaded_effects; also build it for a runtime
+    // that has not been seen yet (e.g. effects loaded before the addon registered)
+    auto it = runtimes_.find(runtime);
+    RuntimeBindings& state = it != runtimes_.end() ? it->second : bind_runtime(runtime);
+    // The audio values only change when the analysis thread publishes a frame or the
+    // configuration changes (amplifier); the render thread usually runs faster than that
+    const bool analysis_changed = !state.uploaded || frame.sequence != state.last_sequence ||
+                                  frame.config_version != state.last_config_version;
+    if (analysis_changed) {
+        refresh_dirty_sources(state, frame);
+        state.last_sequence = frame.sequence;
+        state.last_config_version = frame.config_version;
+        state.uploaded = true;
+    }
+    for (const UniformBinding& binding : state.bindings) {
+        const UniformSourceInfo& info = UniformRegistry::kSources[binding.source];
+        if (info.update == UniformUpdate::OnAnalysis && !(analysis_changed && state.dirty[binding.source])) {
+            continue;
+        }
+        const UniformValue value = info.produce(frame);
+        const uint32_t count = std::min(value.count, binding.element_count);
+        if (value.data && count > 0) {
+            runtime->set_uniform_value_float(binding.handle, value.data, count);
+        }
+    }
+}
+
+void UniformManager::refresh_dirty_sources(RuntimeBindings& state, const UniformFrame& frame) {
+    for (size_t i = 0; i < UniformRegistry::kSourceCount; i++) {
+        const UniformSourceInfo& info = UniformRegistry::kSources[i];
+        if (info.update != UniformUpdate::OnAnalysis) {
+            continue;
+        }
+        const UniformValue value = info.produce(frame);
+        std::vector<float>& last = state.last_values[i];
+        const uint32_t count = value.data ? value.count : 0;
+        const bool same = last.size() == count &&
+                          (count == 0 || std::memcmp(last.data(), value.data, count * sizeof(float)) == 0);
+        // An empty cache after a rebuild always counts as dirty so defaults get overwritten
+        state.dirty[i] = !same || last.empty();
+        if (state.dirty[i]) {
+            last.assign(value.data, value.data + count);
+        }
+    }
 }
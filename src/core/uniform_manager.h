@@ -1,13 +1,54 @@
 #pragma once
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <reshade.hpp>
+#include "uniform_registry.h"
 
 // Manages ReShade uniform updates for Listeningway audio data
 class UniformManager {
 public:
-    // Updates all Listeningway_* uniforms with audio and time data
-    void update_uniforms(reshade::api::effect_runtime* runtime, float volume, const std::vector<float>& freq_bands, float beat,
-                        float time_seconds, float phase_60hz, float phase_120hz, float total_phases_60hz, float total_phases_120hz,
-                        float volume_left = 0.0f, float volume_right = 0.0f, float audio_pan = 0.0f, float audio_format = 0.0f);
+    // Rebuilds the binding table from the runtime's loaded effects (call on reshade_reloaded_effects)
+    void rebuild_bindings(reshade::api::effect_runtime* runtime);
+
+    // Drops the binding table of a runtime (call on destroy_effect_runtime, so a new runtime
+    // allocated at the same address does not inherit stale variable handles)
+    void remove_runtime(reshade::api::effect_runtime* runtime);
+
+    // Updates the Listeningway_* uniforms with audio and time data; audio values are only
+    // re-uploaded when the analysis frame or configuration changed and the value differs
+    void update_uniforms(reshade::api::effect_runtime* runtime, const UniformFrame& frame);
+
+private:
+    // One uniform variable with a Listeningway source annotation
+    struct UniformBinding {
+        reshade::api::effect_uniform_variable handle;
+        UniformSourceId source;
+        uint32_t element_count; // Floats the variable holds (array length x rows x columns)
+    };
+
+    // Binding table and upload cache of one effect runtime (VR and multiple swapchains have
+    // several). Each runtime holds its own uniform values, so each tracks its own uploads
+    struct RuntimeBindings {
+        std::vector<UniformBinding> bindings;
+
+        // Dirty tracking for OnAnalysis sources (reset whenever the binding table is rebuilt)
+        std::array<std::vector<float>, UniformRegistry::kSourceCount> last_values;
+        std::array<bool, UniformRegistry::kSourceCount> dirty{};
+        uint64_t last_sequence = 0;
+        uint64_t last_config_version = 0;
+        bool uploaded = false; // False until the first upload after a rebuild
+    };
+
+    // Builds (or rebuilds) the table of a runtime; mutex_ must be held
+    RuntimeBindings& bind_runtime(reshade::api::effect_runtime* runtime);
+
+    // Compares each OnAnalysis source with the runtime's last upload and marks what has to be written
+    static void refresh_dirty_sources(RuntimeBindings& state, const UniformFrame& frame);
+
+    std::mutex mutex_; // Runtimes may present on different threads (see LatestFrame() in the addon)
+    std::unordered_map<reshade::api::effect_runtime*, RuntimeBindings> runtimes_;
 };
@@ -0,0 +1,155 @@
+// ---------------------------------------------
+// Uniform Registry
+// Compile-time table of the Listeningway uniform sources
+// ---------------------------------------------
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+/**
+ * @brief Values of one rendered frame that uniforms can be bound to.
+ */
+struct UniformFrame {
+    uint64_t sequence = 0;        // Analysis frame the audio values come from
+    uint64_t config_version = 0;  // Configuration the values were scaled with (amplifier)
+    float volume = 0.0f;
+    const float* freq_bands = nullptr;
+    uint32_t freq_band_count = 0;
+    float beat = 0.0f;
+    float time_seconds = 0.0f;
+    float phase_60hz = 0.0f;
+    float phase_120hz = 0.0f;
+    float total_phases_60hz = 0.0f;
+    float total_phases_120hz = 0.0f;
+    float volume_left = 0.0f;
+    float volume_right = 0.0f;
+    float audio_pan = 0.0f;
+    float audio_format = 0.0f;
+    float beat_phase = 0.0f;
+    float time_to_next_beat = 0.0f;
+};
+
+/**
+ * @brief Floats a source produces for one frame (points into the UniformFrame).
+ */
+struct UniformValue {
+    const float* data;
+    uint32_t count;
+};
+
+enum class UniformValueType : uint8_t {
+    Float,      // Single float
+    FloatArray  // float[N]; the upload is clamped to the uniform's declared size
+};
+
+enum class UniformUpdate : uint8_t {
+    OnAnalysis, // Changes only with a new analysis frame or configuration
+    EveryFrame  // Advances every rendered frame (time and phase)
+};
+
+/**
+ * @brief One "source" annotation value and how to produce its data.
+ */
+struct UniformSourceInfo {
+    std::string_view name;
+    UniformValueType type;
+    UniformUpdate update;
+    UniformValue (*produce)(const UniformFrame& frame);
+};
+
+// Index of a source in UniformRegistry::kSources
+using UniformSourceId = uint8_t;
+
+namespace UniformRegistry {
+
+// Every source a shader can bind with `source = "..."`. Adding a uniform is one entry here
+// (plus its field in UniformFrame); lookup and dispatch pick it up automatically.
+inline constexpr UniformSourceInfo kSources[] = {
+    { "listeningway_volume",           UniformValueType::Float,      UniformUpdate::OnAnalysis, [](const UniformFrame& f) { return UniformValue{ &f.volume, 1 }; } },
+    { "listeningway_freqbands",        UniformValueType::FloatArray, UniformUpdate::OnAnalysis, [](const UniformFrame& f) { return UniformValue{ f.freq_bands, f.freq_band_count }; } },
+    { "listeningway_beat",             UniformValueType::Float,      UniformUpdate::OnAnalysis, [](const UniformFrame& f) { return UniformValue{ &f.beat, 1 }; } },
+    { "listeningway_timeseconds",      UniformValueType::Float,      UniformUpdate::EveryFrame, [](const UniformFrame& f) { return UniformValue{ &f.time_seconds, 1 }; } },
+    { "listeningway_timephase60hz",    UniformValueType::Float,      UniformUpdate::EveryFrame, [](const UniformFrame& f) { return UniformValue{ &f.phase_60hz, 1 }; } },
+    { "listeningway_timephase120hz",   UniformValueType::Float,      UniformUpdate::EveryFrame, [](const UniformFrame& f) { return UniformValue{ &f.phase_120hz, 1 }; } },
+    { "listeningway_totalphases60hz",  UniformValueType::Float,      UniformUpdate::EveryFrame, [](const UniformFrame& f) { return UniformValue{ &f.total_phases_60hz, 1 }; } },
+    { "listeningway_totalphases120hz", UniformValueType::Float,      UniformUpdate::EveryFrame, [](const UniformFrame& f) { return UniformValue{ &f.total_phases_120hz, 1 }; } },
+    { "listeningway_volumeleft",       UniformValueType::Float,      UniformUpdate::OnAnalysis, [](const UniformFrame& f) { return UniformValue{ &f.volume_left, 1 }; } },
+    { "listeningway_volumeright",      UniformValueType::Float,      UniformUpdate::OnAnalysis, [](const UniformFrame& f) { return UniformValue{ &f.volume_right, 1 }; } },
+    { "listeningway_audiopan",         UniformValueType::Float,      UniformUpdate::OnAnalysis, [](const UniformFrame& f) { return UniformValue{ &f.audio_pan, 1 }; } },
+    { "listeningway_audioformat",      UniformValueType::Float,      UniformUpdate::OnAnalysis, [](const UniformFrame& f) { return UniformValue{ &f.audio_format, 1 }; } },
+    { "listeningway_beatphase",        UniformValueType::Float,      UniformUpdate::EveryFrame, [](const UniformFrame& f) { return UniformValue{ &f.beat_phase, 1 }; } },
+    { "listeningway_timetonextbeat",   UniformValueType::Float,      UniformUpdate::EveryFrame, [](const UniformFrame& f) { return UniformValue{ &f.time_to_next_beat, 1 }; } },
+};
+
+inline constexpr size_t kSourceCount = std::size(kSources);
+static_assert(kSourceCount <= 256, "UniformSourceId is 8 bits");
+
+// FNV-1a; only has to be collision-free over the registered names (checked below)
+constexpr uint32_t HashName(std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+struct HashSlot {
+    uint32_t hash;
+    UniformSourceId id;
+};
+
+// Source hashes sorted at compile time for a binary search
+constexpr std::array<HashSlot, kSourceCount> BuildHashIndex() {
+    std::array<HashSlot, kSourceCount> index{};
+    for (size_t i = 0; i < kSourceCount; i++) {
+        HashSlot slot{ HashName(kSources[i].name), static_cast<UniformSourceId>(i) };
+        size_t j = i;
+        for (; j > 0 && index[j - 1].hash > slot.hash; j--) {
+            index[j] = index[j - 1];
+        }
+        index[j] = slot;
+    }
+    return index;
+}
+
+inline constexpr std::array<HashSlot, kSourceCount> kHashIndex = BuildHashIndex();
+
+constexpr bool HashesAreUnique() {
+    for (size_t i = 1; i < kSourceCount; i++) {
+        if (kHashIndex[i - 1].hash == kHashIndex[i].hash) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(HashesAreUnique(), "Two uniform source names share a hash; rename one");
+
+/**
+ * @brief Look up a "source" annotation value
+ * @param name Annotation string
+ * @param out_id Registry index of the source when found
+ * @return False for names that are not Listeningway sources
+ */
+constexpr bool Find(std::string_view name, UniformSourceId& out_id) {
+    const uint32_t hash = HashName(name);
+    size_t lo = 0, hi = kSourceCount;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (kHashIndex[mid].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    // Hashes are unique, so one string compare confirms the match
+    if (lo < kSourceCount && kHashIndex[lo].hash == hash && kSources[kHashIndex[lo].id].name == name) {
+        out_id = kHashIndex[lo].id;
+        return true;
+    }
+    return false;
+}
+
+} // namespace UniformRegistry
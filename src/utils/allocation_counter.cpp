@@ -0,0 +1,53 @@
+// ---------------------------------------------
+// Allocation Counter Implementation
+// Opt-in replacement of global operator new that counts per-thread allocations
+// ---------------------------------------------
+#include "allocation_counter.h"
+
+#ifdef LISTENINGWAY_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+static thread_local size_t t_allocations = 0;
+
+void* operator new(size_t size) {
+    ++t_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    ++t_allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace AllocationCounter {
+bool Enabled() { return true; }
+size_t ThreadAllocations() { return t_allocations; }
+} // namespace AllocationCounter
+
+#else
+
+namespace AllocationCounter {
+bool Enabled() { return false; }
+size_t ThreadAllocations() { return 0; }
+} // namespace AllocationCounter
+
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+
+// Heap allocation counting for verifying the real-time audio path.
+//
+// Only active when built with LISTENINGWAY_COUNT_ALLOCATIONS (CMake option of the
+// same name): global operator new is then replaced by a counting version. In normal
+// builds the functions are no-ops and Enabled() returns false.
+namespace AllocationCounter {
+
+// True if allocation counting was compiled in
+bool Enabled();
+
+// Number of operator new calls made by the calling thread so far
+size_t ThreadAllocations();
+
+} // namespace AllocationCounter
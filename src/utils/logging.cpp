@@ -10,7 +10,6 @@
 #include <ctime>
 
 static std::ofstream g_log_file;
-extern bool g_listeningway_debug_enabled;
 
 static std::string GetLogFilePath() {
     std::string ini = GetSettingsPath();
@@ -22,7 +21,7 @@ static std::string GetLogFilePath() {
 // Writes a timestamped message to the log file (thread-safe)
 void LogToFile(const std::string& message, LogLevel level) {
     // Always log errors, only log debug if enabled
-    if (level == LogLevel::Debug && !g_listeningway_debug_enabled) return;
+    if (level == LogLevel::Debug && !Listeningway::RuntimeFlags::DebugEnabled()) return;
     LOCK_LOGGING();
     if (g_log_file.is_open()) {
         // Get current time for timestamp
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include "runtime_flags.h"
 
 enum class LogLevel {
     Debug,
@@ -10,10 +11,12 @@ enum class LogLevel {
 void LogToFile(const std::string& message, LogLevel level = LogLevel::Debug);
 
 // Logging macros
-#define LOG_DEBUG(msg) LogToFile(msg, LogLevel::Debug)
+// Debug-level macros test the flag before evaluating msg, so disabled logging
+// never builds the message string (no allocations on the audio thread).
+#define LOG_DEBUG(msg) do { if (Listeningway::RuntimeFlags::DebugEnabled()) LogToFile(msg, LogLevel::Debug); } while (0)
 #define LOG_ERROR(msg) LogToFile(msg, LogLevel::Error)
-#define LOG_WARNING(msg) LogToFile(msg, LogLevel::Debug)
-#define LOG_INFO(msg) LogToFile(msg, LogLevel::Debug)
+#define LOG_WARNING(msg) LOG_DEBUG(msg)
+#define LOG_INFO(msg) LOG_DEBUG(msg)
 
 // Log file management
 void OpenLogFile(const std::string& filename);
@@ -0,0 +1,14 @@
+// ---------------------------------------------
+// Runtime Flags Implementation
+// ---------------------------------------------
+#include "runtime_flags.h"
+#include "constants.h"
+
+namespace Listeningway {
+
+// Match Configuration's defaults until ConfigurationManager publishes its first snapshot
+std::atomic<bool> RuntimeFlags::analysis_enabled_{ false };
+std::atomic<bool> RuntimeFlags::debug_enabled_{ DEFAULT_DEBUG_ENABLED };
+std::atomic<int> RuntimeFlags::beat_algorithm_{ DEFAULT_BEAT_DETECTION_ALGORITHM };
+
+} // namespace Listeningway
@@ -0,0 +1,52 @@
+// ---------------------------------------------
+// Runtime Flags
+// Hot on/off switches mirrored from the published configuration as atomics
+// ---------------------------------------------
+#pragma once
+#include <atomic>
+
+namespace Listeningway {
+
+/**
+ * @brief Lock-free view of the runtime switches that are checked per packet or per log call.
+ *
+ * The persisted Configuration stays the source of truth. ConfigurationManager is the only
+ * writer: every time it publishes a snapshot it stores these flags from that snapshot, so
+ * they always agree with ConfigurationManager::Current() once the publish returns. Code
+ * that wants to change a switch edits the configuration and publishes; it never stores here.
+ *
+ * Memory-ordering contract:
+ * - Stores are made with release ordering, after the new snapshot has been swapped in.
+ * - Readers load with relaxed ordering. Each flag is an independent hint used to skip or
+ *   gate work (analysis, logging); no other data is published through it, so observing a
+ *   change a packet late is harmless.
+ * - A reader that needs settings that belong together (e.g. the algorithm and its
+ *   tunables) must take ConfigurationManager::Current() instead of combining flags.
+ */
+class RuntimeFlags {
+public:
+    /// audio.analysisEnabled
+    static bool AnalysisEnabled() { return analysis_enabled_.load(std::memory_order_relaxed); }
+
+    /// debug.debugEnabled; gates LOG_DEBUG
+    static bool DebugEnabled() { return debug_enabled_.load(std::memory_order_relaxed); }
+
+    /// beat.algorithm
+    static int BeatAlgorithm() { return beat_algorithm_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Mirror a newly published configuration (ConfigurationManager only)
+     */
+    static void Store(bool analysis_enabled, bool debug_enabled, int beat_algorithm) {
+        analysis_enabled_.store(analysis_enabled, std::memory_order_release);
+        debug_enabled_.store(debug_enabled, std::memory_order_release);
+        beat_algorithm_.store(beat_algorithm, std::memory_order_release);
+    }
+
+private:
+    static std::atomic<bool> analysis_enabled_;
+    static std::atomic<bool> debug_enabled_;
+    static std::atomic<int> beat_algorithm_;
+};
+
+} // namespace Listeningway
@@ -1 +1,95 @@
-// Implementation for common threading/atomic utilities (if needed)
+// Implementation for common threading/atomic utilities
+#include "threading.h"
+#include "logging.h"
+#include <algorithm>
+#include <string>
+
+// Initial ring capacity; detectors keep at most one job in flight
+static constexpr size_t INITIAL_QUEUE_CAPACITY = 8;
+
+WorkerPool::WorkerPool(size_t thread_count)
+    : jobs_(INITIAL_QUEUE_CAPACITY), thread_count_(std::max<size_t>(thread_count, 1)) {
+}
+
+WorkerPool::~WorkerPool() {
+    Stop();
+}
+
+void WorkerPool::Start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    stopping_ = false;
+    for (size_t i = 0; i < thread_count_; i++) {
+        threads_.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+    LOG_DEBUG("[WorkerPool] Started " + std::to_string(thread_count_) + " worker(s)");
+}
+
+void WorkerPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (std::thread& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_.clear();
+        running_ = false;
+        stopping_ = false;
+    }
+    LOG_DEBUG("[WorkerPool] Stopped");
+}
+
+bool WorkerPool::Submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || stopping_) {
+            return false;
+        }
+        if (queued_ == jobs_.size()) {
+            GrowQueueLocked();
+        }
+        jobs_[(head_ + queued_) % jobs_.size()] = std::move(job);
+        queued_++;
+    }
+    work_available_.notify_one();
+    return true;
+}
+
+void WorkerPool::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_available_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+        if (queued_ == 0) {
+            return; // Stopping and drained
+        }
+        Job job = std::move(jobs_[head_]);
+        jobs_[head_] = nullptr;
+        head_ = (head_ + 1) % jobs_.size();
+        queued_--;
+        lock.unlock();
+        job();
+        lock.lock();
+    }
+}
+
+void WorkerPool::GrowQueueLocked() {
+    // Unroll the ring into a larger one, oldest job first
+    std::vector<Job> grown(jobs_.size() * 2);
+    for (size_t i = 0; i < queued_; i++) {
+        grown[i] = std::move(jobs_[(head_ + i) % jobs_.size()]);
+    }
+    jobs_.swap(grown);
+    head_ = 0;
+}
@@ -1,7 +1,129 @@
 #pragma once
+#include <array>
 #include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <thread>
 #include <mutex>
+#include <vector>
 
 // Common threading/atomic utilities for Listeningway
 // Add reusable thread helpers here as needed.
+
+/**
+ * @brief Wait-free single-producer/single-consumer triple buffer.
+ *
+ * The writer fills Write() and calls Publish(); the reader calls Read() to get the most
+ * recently published value. Neither side ever blocks on the other: the three slots are
+ * handed over by atomically exchanging slot indices, so the writer always owns one slot,
+ * the reader owns one, and the third holds the latest published value.
+ *
+ * Publish() uses release semantics and Read() acquire semantics, so everything written to
+ * the slot before Publish() is visible to the reader that picks it up. The reference
+ * returned by Read() stays valid and unchanged until the next Read().
+ *
+ * There is one reader slot, so there may only be one reader at a time: callers with
+ * several reader threads must serialize Read() and finish using the returned value
+ * before the next Read() (AudioAnalyzer::CopyLatestFrame copies it out under a mutex).
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) : slots_{ { initial, initial, initial } } {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Writer-owned slot for the next value (writer thread only)
+     */
+    T& Write() { return slots_[back_]; }
+
+    /**
+     * @brief Make the Write() slot the latest value and take over a free slot (writer thread only)
+     */
+    void Publish() {
+        back_ = middle_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    /**
+     * @brief Latest published value (reader thread only, never blocks)
+     */
+    const T& Read() {
+        if (middle_.load(std::memory_order_relaxed) & kFresh) {
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        }
+        return slots_[front_];
+    }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh = 0x4; // Set in middle_ while it holds a value the reader has not seen
+
+    std::array<T, 3> slots_;
+    uint8_t back_ = 0;                     // Writer-owned slot index
+    alignas(64) std::atomic<uint8_t> middle_{ 1 }; // Shared slot index plus kFresh
+    alignas(64) uint8_t front_ = 2;        // Reader-owned slot index
+};
+
+/**
+ * @brief Small pool of background threads that run submitted jobs in FIFO order.
+ *
+ * Workers block on a condition variable while the queue is empty, so an idle pool costs
+ * no wakeups and a submitted job starts as soon as a worker is free. Threads are created
+ * by Start() and joined by Stop(); in between, Submit() is cheap (one short lock and a
+ * notify) and can be called from the analysis thread.
+ *
+ * Stop() runs the jobs that are still queued before joining, so a submitter that waits
+ * for its own job to finish cannot hang on a job that was dropped.
+ *
+ * Queued jobs live in a ring that only grows when it is full, so submitting a job whose
+ * callable fits std::function's inline storage (such as a lambda capturing `this`) does
+ * not allocate once the pool is warmed up.
+ */
+class WorkerPool {
+public:
+    using Job = std::function<void()>;
+
+    /**
+     * @param thread_count Worker threads created by Start() (at least one)
+     */
+    explicit WorkerPool(size_t thread_count = 1);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Create the worker threads (no-op if already running)
+     */
+    void Start();
+
+    /**
+     * @brief Finish the queued jobs and join the worker threads (no-op if not running)
+     */
+    void Stop();
+
+    /**
+     * @brief Queue a job for a worker thread
+     * @return False if the pool is not running; the job is not queued then
+     */
+    bool Submit(Job job);
+
+private:
+    void WorkerLoop();
+    void GrowQueueLocked();
+
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::vector<Job> jobs_;                // Ring of queued jobs (capacity only grows)
+    size_t head_ = 0;                      // Index of the oldest queued job
+    size_t queued_ = 0;                    // Number of queued jobs
+    std::vector<std::thread> threads_;
+    size_t thread_count_;
+    bool running_ = false;
+    bool stopping_ = false;
+};
@@ -0,0 +1,84 @@
+// ---------------------------------------------
+// Allocation Test
+// Once warmed up, analyzing a packet (beat detection and publishing included) must not
+// touch the heap. The test support library is built with LISTENINGWAY_COUNT_ALLOCATIONS,
+// so the analyzer counts every operator new it makes in steady state.
+// ---------------------------------------------
+#include "test_common.h"
+#include "audio/analysis/audio_analysis.h"
+#include "allocation_counter.h"
+#include "configuration/configuration_manager.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr size_t PACKET_FRAMES = 480;     // 10 ms, a typical shared-mode WASAPI period
+constexpr size_t PACKETS_PER_SECOND = 100;
+constexpr float TEMPO_BPM = 120.0f;
+constexpr int WARMUP_SECONDS = 3;         // Detector history and the first tempo jobs
+constexpr int STEADY_SECONDS = 40;        // Covers many tempo jobs (one every 2 s)
+
+// Stereo kick drum pattern (decaying 60 Hz bursts) over a quiet 1 kHz tone
+void FillPacket(size_t packet, std::vector<float>& interleaved) {
+    const float beat_period = 60.0f / TEMPO_BPM;
+    const float two_pi = 6.2831853f;
+    for (size_t i = 0; i < PACKET_FRAMES; i++) {
+        const float t = static_cast<float>(packet * PACKET_FRAMES + i) / SAMPLE_RATE;
+        const float since_beat = std::fmod(t, beat_period);
+        const float kick = std::exp(-since_beat * 30.0f) * std::sin(two_pi * 60.0f * since_beat);
+        const float tone = 0.05f * std::sin(two_pi * 1000.0f * t);
+        interleaved[2 * i] = 0.8f * kick + tone;
+        interleaved[2 * i + 1] = 0.6f * kick + tone;
+    }
+}
+
+// Feeds whole seconds of packets; the short pause per second lets the tempo jobs finish
+// so their results are picked up on the analysis side as in a live session
+void Feed(AudioAnalyzer& analyzer, AudioAnalysisData& data, size_t& packet, int seconds) {
+    std::vector<float> interleaved(PACKET_FRAMES * 2);
+    for (int second = 0; second < seconds; second++) {
+        for (size_t i = 0; i < PACKETS_PER_SECOND; i++, packet++) {
+            FillPacket(packet, interleaved);
+            analyzer.AnalyzeAudioBuffer(interleaved.data(), PACKET_FRAMES, 2, data);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+void CheckAlgorithm(int algorithm) {
+    Listeningway::ConfigurationManager& manager = Listeningway::ConfigurationManager::Instance();
+    Listeningway::Configuration& config = manager.GetConfig();
+    config.audio.analysisEnabled = true;
+    config.debug.debugEnabled = false; // Debug logging is exempt from the check
+    config.beat.algorithm = algorithm;
+    manager.PublishIfChanged();
+
+    AudioAnalyzer analyzer;
+    AudioAnalysisData data(config.frequency.bands);
+    analyzer.Start();
+    size_t packet = 0;
+    Feed(analyzer, data, packet, WARMUP_SECONDS);
+    const size_t warmup_allocations = analyzer.GetSteadyStateAllocationCount();
+    Feed(analyzer, data, packet, STEADY_SECONDS);
+    const size_t steady_allocations = analyzer.GetSteadyStateAllocationCount();
+    analyzer.Stop();
+
+    CHECK_MSG(warmup_allocations == 0, "algorithm %d: %zu allocation(s) during warm-up",
+              algorithm, warmup_allocations);
+    CHECK_MSG(steady_allocations == 0, "algorithm %d: %zu allocation(s) in steady state",
+              algorithm, steady_allocations);
+}
+
+} // namespace
+
+int main() {
+    CHECK(AllocationCounter::Enabled());
+    for (int algorithm = 0; algorithm <= 2; algorithm++) {
+        CheckAlgorithm(algorithm);
+    }
+    return TEST_RESULT();
+}
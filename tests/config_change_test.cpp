@@ -0,0 +1,83 @@
+// ---------------------------------------------
+// Config Change Test
+// The band caches must follow the snapshot a frame is analyzed with, even when the change
+// notification for that snapshot has not reached the analyzer yet
+// ---------------------------------------------
+#include "test_common.h"
+#include "audio/analysis/audio_analysis.h"
+#include "configuration/configuration_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr size_t PACKET_FRAMES = 480;
+constexpr size_t PACKETS = 50;           // Enough to refill the STFT window several times
+constexpr float TONE_HZ = 1500.0f;       // Centered on a bin for 256 and 512 point FFTs
+constexpr float TOLERANCE = 1e-4f;
+
+// Quiet stereo tone (keeps the raw bands below their 1.0 clamp)
+void Feed(AudioAnalyzer& analyzer, AudioAnalysisData& data, size_t& packet) {
+    std::vector<float> interleaved(PACKET_FRAMES * 2);
+    for (size_t p = 0; p < PACKETS; p++, packet++) {
+        for (size_t i = 0; i < PACKET_FRAMES; i++) {
+            const float t = static_cast<float>(packet * PACKET_FRAMES + i) / SAMPLE_RATE;
+            interleaved[2 * i] = interleaved[2 * i + 1] = 0.01f * std::sin(6.2831853f * TONE_HZ * t);
+        }
+        analyzer.AnalyzeAudioBuffer(interleaved.data(), PACKET_FRAMES, 2, data);
+    }
+}
+
+void Publish(size_t bands, size_t fft_size) {
+    Listeningway::ConfigurationManager& manager = Listeningway::ConfigurationManager::Instance();
+    Listeningway::Configuration& config = manager.GetConfig();
+    config.audio.analysisEnabled = true;
+    config.frequency.bands = bands;
+    config.frequency.fftSize = fft_size;
+    config.frequency.hopSize = fft_size;
+    manager.PublishIfChanged();
+}
+
+} // namespace
+
+int main() {
+    Publish(32, 512);
+    AudioAnalyzer analyzer;
+    analyzer.SetStreamSampleRate(SAMPLE_RATE);
+    AudioAnalysisData data(32);
+    analyzer.Start();
+    size_t packet = 0;
+    Feed(analyzer, data, packet);
+
+    // Publish fewer bands and a smaller FFT without the analyzer hearing about it, as when
+    // the analysis thread runs between a publish and the listener notification
+    Listeningway::ConfigurationManager::Instance().RemoveChangeListener(&analyzer);
+    Publish(8, 256);
+    size_t stale_packet = packet;
+    Feed(analyzer, data, stale_packet);
+    analyzer.Stop();
+
+    // Reference: an analyzer that started with the new layout, fed the same packets
+    AudioAnalyzer reference;
+    reference.SetStreamSampleRate(SAMPLE_RATE);
+    AudioAnalysisData expected(8);
+    reference.Start();
+    Feed(reference, expected, packet);
+    reference.Stop();
+
+    CHECK(data.freq_bands.size() == 8 && data.raw_freq_bands.size() == 8);
+    if (data.freq_bands.size() == expected.freq_bands.size()) {
+        float peak = 0.0f;
+        for (size_t b = 0; b < expected.freq_bands.size(); b++) {
+            peak = std::max(peak, expected.raw_freq_bands[b]);
+            CHECK_MSG(std::abs(data.raw_freq_bands[b] - expected.raw_freq_bands[b]) <= TOLERANCE &&
+                      std::abs(data.freq_bands[b] - expected.freq_bands[b]) <= TOLERANCE,
+                      "band %zu: raw %g vs %g, eq %g vs %g", b, data.raw_freq_bands[b],
+                      expected.raw_freq_bands[b], data.freq_bands[b], expected.freq_bands[b]);
+        }
+        CHECK(peak > 0.0f);
+    }
+    return TEST_RESULT();
+}
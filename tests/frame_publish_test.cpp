@@ -0,0 +1,63 @@
+// ---------------------------------------------
+// Frame Publish Test
+// Several threads may read analysis frames (runtimes presenting on different threads and the
+// overlay) while the analysis thread publishes; every copy must be one whole frame
+// ---------------------------------------------
+#include "test_common.h"
+#include "audio/analysis/audio_analysis.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t BANDS = 64;
+constexpr uint64_t FRAMES = 200000;
+constexpr int READERS = 3;
+
+// Counts copies whose bands do not all hold the same value (a slot overwritten mid-copy)
+void Read(AudioAnalyzer& analyzer, const std::atomic_bool& done, std::atomic<size_t>& torn) {
+    AudioAnalysisData frame(BANDS);
+    while (!done.load(std::memory_order_acquire)) {
+        analyzer.CopyLatestFrame(frame);
+        for (float band : frame.freq_bands) {
+            if (band != frame.freq_bands.front() || band != frame.volume) {
+                torn++;
+                break;
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    AudioAnalyzer analyzer;
+    std::atomic_bool done = false;
+    std::atomic<size_t> torn = 0;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READERS; i++) {
+        readers.emplace_back(Read, std::ref(analyzer), std::cref(done), std::ref(torn));
+    }
+
+    // Each frame carries its number in the volume and in every band
+    AudioAnalysisData frame(BANDS);
+    for (uint64_t i = 1; i <= FRAMES; i++) {
+        const float value = static_cast<float>(i);
+        frame.volume = value;
+        std::fill(frame.freq_bands.begin(), frame.freq_bands.end(), value);
+        analyzer.PublishFrame(frame);
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    CHECK_MSG(torn.load() == 0, "%zu torn frame copies", torn.load());
+    AudioAnalysisData last;
+    analyzer.CopyLatestFrame(last);
+    CHECK(last.volume == static_cast<float>(FRAMES) && last.sequence == FRAMES);
+    return TEST_RESULT();
+}
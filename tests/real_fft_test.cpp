@@ -0,0 +1,67 @@
+// ---------------------------------------------
+// Real FFT Test
+// The real-input transform used for the mono downmix must give the same magnitudes as
+// the complex transform it replaced
+// ---------------------------------------------
+#include "test_common.h"
+#include "audio/analysis/fft_plan_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Largest magnitude difference allowed, relative to the strongest bin (float round-off
+// grows with log2(size); both transforms use the same twiddles, so this is generous)
+constexpr float TOLERANCE = 1e-5f;
+
+void CheckSize(size_t size, std::mt19937& rng) {
+    FftPlan complex_plan(size, false);
+    RealFftPlan real_plan(size, false);
+    CHECK_MSG(complex_plan.IsValid() && real_plan.IsValid(), "size %zu", size);
+    if (!complex_plan.IsValid() || !real_plan.IsValid()) {
+        return;
+    }
+
+    // Noise plus a tone and a DC offset, so every bin (including DC and Nyquist) is exercised
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<kiss_fft_scalar> samples(size);
+    std::vector<kiss_fft_cpx> complex_in(size);
+    for (size_t i = 0; i < size; i++) {
+        samples[i] = 0.25f + 0.5f * std::sin(0.3f * static_cast<float>(i)) + noise(rng);
+        complex_in[i].r = samples[i];
+        complex_in[i].i = 0.0f;
+    }
+
+    std::vector<kiss_fft_cpx> complex_out(size);
+    std::vector<kiss_fft_cpx> real_out(size / 2 + 1);
+    complex_plan.Execute(complex_in.data(), complex_out.data());
+    real_plan.Execute(samples.data(), real_out.data());
+
+    // The analyzer only reads bins 0..size/2
+    float peak = 0.0f;
+    for (size_t k = 0; k <= size / 2; k++) {
+        peak = std::max(peak, std::hypot(complex_out[k].r, complex_out[k].i));
+    }
+    const float limit = TOLERANCE * std::max(peak, 1.0f);
+    for (size_t k = 0; k <= size / 2; k++) {
+        const float expected = std::hypot(complex_out[k].r, complex_out[k].i);
+        const float actual = std::hypot(real_out[k].r, real_out[k].i);
+        CHECK_MSG(std::abs(expected - actual) <= limit,
+                  "size %zu, bin %zu: complex %g, real %g", size, k, expected, actual);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(1234);
+    // Powers of two (the fftSize presets) and other even sizes kiss_fftr accepts
+    for (size_t size : { 2, 4, 8, 16, 64, 256, 512, 1024, 2048, 4096, 8192, 6, 10, 12, 30, 100, 480, 1000, 1536 }) {
+        CheckSize(size, rng);
+    }
+    // Odd sizes are rejected so the analyzer falls back to the complex transform
+    CHECK(!RealFftPlan(1023, false).IsValid());
+    return TEST_RESULT();
+}
@@ -0,0 +1,171 @@
+// ---------------------------------------------
+// SIMD Kernels Test
+// Every vectorized kernel table must match the scalar table, including the remainder loops
+// (short and odd lengths) and unaligned buffers
+// ---------------------------------------------
+#include "test_common.h"
+#include "audio/analysis/simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using SimdKernels::KernelTable;
+
+namespace {
+
+// Reductions may be summed in a different order, so they are compared relative to the sum of
+// the absolute terms; element-wise results allow one rounding step
+constexpr float REDUCTION_TOLERANCE = 1e-5f;
+constexpr float ELEMENT_TOLERANCE = 1e-6f;
+
+// Offsets (in elements) into the test buffers, so loads start off the vector alignment
+constexpr size_t MAX_OFFSET = 3;
+
+bool Close(float expected, float actual, float scale, float tolerance) {
+    return std::abs(expected - actual) <= tolerance * std::max(scale, 1.0f);
+}
+
+std::vector<size_t> Lengths() {
+    std::vector<size_t> lengths;
+    for (size_t n = 0; n <= 17; n++) {
+        lengths.push_back(n);
+    }
+    for (size_t n = 1023; n <= 1027; n++) {
+        lengths.push_back(n);
+    }
+    return lengths;
+}
+
+struct Inputs {
+    std::vector<kiss_fft_cpx> bins;
+    std::vector<float> current, previous, a, b, stereo;
+};
+
+Inputs MakeInputs(size_t size, std::mt19937& rng) {
+    std::uniform_real_distribution<float> signal(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> magnitude(0.0f, 4.0f);
+    Inputs in;
+    in.bins.resize(size);
+    in.current.resize(size);
+    in.previous.resize(size);
+    in.a.resize(size);
+    in.b.resize(size);
+    in.stereo.resize(2 * size);
+    for (size_t i = 0; i < size; i++) {
+        in.bins[i].r = 3.0f * signal(rng);
+        in.bins[i].i = 3.0f * signal(rng);
+        in.current[i] = magnitude(rng);
+        in.previous[i] = magnitude(rng);
+        in.a[i] = signal(rng);
+        in.b[i] = signal(rng);
+    }
+    for (float& sample : in.stereo) {
+        sample = signal(rng);
+    }
+    return in;
+}
+
+void CheckMagnitudes(const KernelTable& table, const Inputs& in, size_t offset, size_t count) {
+    std::vector<float> expected(count + MAX_OFFSET), actual(count + MAX_OFFSET);
+    SimdKernels::Scalar().magnitudes(in.bins.data() + offset, expected.data() + offset, count);
+    table.magnitudes(in.bins.data() + offset, actual.data() + offset, count);
+    for (size_t i = 0; i < count; i++) {
+        const float e = expected[offset + i];
+        const float a = actual[offset + i];
+        CHECK_MSG(Close(e, a, e, ELEMENT_TOLERANCE), "%s magnitudes: count %zu, offset %zu, bin %zu: %g vs %g",
+                  table.name, count, offset, i, e, a);
+    }
+}
+
+void CheckPositiveFlux(const KernelTable& table, const Inputs& in, size_t offset, size_t count) {
+    const float* current = in.current.data() + offset;
+    const float* previous = in.previous.data() + offset;
+    float scale = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        scale += std::abs(current[i] - previous[i]);
+    }
+    // Low band empty, one bin, a third, all bins and past the end (clamped)
+    for (size_t low_count : { size_t(0), size_t(1), count / 3, count, count + 5 }) {
+        float flux_e = -1.0f, low_e = -1.0f, flux_a = -1.0f, low_a = -1.0f;
+        SimdKernels::Scalar().positive_flux(current, previous, count, low_count, &flux_e, &low_e);
+        table.positive_flux(current, previous, count, low_count, &flux_a, &low_a);
+        CHECK_MSG(Close(flux_e, flux_a, scale, REDUCTION_TOLERANCE) && Close(low_e, low_a, scale, REDUCTION_TOLERANCE),
+                  "%s positive_flux: count %zu, offset %zu, low_count %zu: %g/%g vs %g/%g",
+                  table.name, count, offset, low_count, flux_e, low_e, flux_a, low_a);
+    }
+}
+
+void CheckMultiply(const KernelTable& table, const Inputs& in, size_t offset, size_t count) {
+    // One rounded product per element, so the results must be identical
+    std::vector<float> expected(count + MAX_OFFSET), actual(count + MAX_OFFSET);
+    SimdKernels::Scalar().multiply(in.a.data() + offset, in.b.data() + offset, expected.data() + offset, count);
+    table.multiply(in.a.data() + offset, in.b.data() + offset, actual.data() + offset, count);
+    CHECK_MSG(std::equal(expected.begin() + offset, expected.begin() + offset + count, actual.begin() + offset),
+              "%s multiply: count %zu, offset %zu", table.name, count, offset);
+
+    // In place (out aliases a), as the analyzer applies its window
+    std::vector<float> in_place(in.a);
+    table.multiply(in_place.data() + offset, in.b.data() + offset, in_place.data() + offset, count);
+    CHECK_MSG(std::equal(expected.begin() + offset, expected.begin() + offset + count, in_place.begin() + offset),
+              "%s multiply in place: count %zu, offset %zu", table.name, count, offset);
+}
+
+void CheckSum(const KernelTable& table, const Inputs& in, size_t offset, size_t count) {
+    const float* data = in.a.data() + offset;
+    float scale = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        scale += std::abs(data[i]);
+    }
+    const float expected = SimdKernels::Scalar().sum(data, count);
+    const float actual = table.sum(data, count);
+    CHECK_MSG(Close(expected, actual, scale, REDUCTION_TOLERANCE), "%s sum: count %zu, offset %zu: %g vs %g",
+              table.name, count, offset, expected, actual);
+}
+
+void CheckAccumulateStereo(const KernelTable& table, const Inputs& in, size_t offset, size_t frames) {
+    const float* data = in.stereo.data() + offset;
+    std::vector<float> mono_e(frames + MAX_OFFSET), mono_a(frames + MAX_OFFSET);
+    float left_e = -1.0f, right_e = -1.0f, left_a = -1.0f, right_a = -1.0f;
+    SimdKernels::Scalar().accumulate_stereo(data, frames, mono_e.data() + offset, &left_e, &right_e);
+    table.accumulate_stereo(data, frames, mono_a.data() + offset, &left_a, &right_a);
+
+    // Halving is exact, so the downmix must be identical
+    CHECK_MSG(std::equal(mono_e.begin() + offset, mono_e.begin() + offset + frames, mono_a.begin() + offset),
+              "%s accumulate_stereo mono: frames %zu, offset %zu", table.name, frames, offset);
+    // Squares are non-negative, so the reference energy is its own scale
+    CHECK_MSG(Close(left_e, left_a, left_e, REDUCTION_TOLERANCE) && Close(right_e, right_a, right_e, REDUCTION_TOLERANCE),
+              "%s accumulate_stereo energy: frames %zu, offset %zu: %g/%g vs %g/%g",
+              table.name, frames, offset, left_e, right_e, left_a, right_a);
+}
+
+void CheckTable(const KernelTable& table, std::mt19937& rng) {
+    for (size_t count : Lengths()) {
+        const Inputs in = MakeInputs(count + MAX_OFFSET, rng);
+        for (size_t offset = 0; offset <= MAX_OFFSET; offset++) {
+            CheckMagnitudes(table, in, offset, count);
+            CheckPositiveFlux(table, in, offset, count);
+            CheckMultiply(table, in, offset, count);
+            CheckSum(table, in, offset, count);
+            CheckAccumulateStereo(table, in, offset, count);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(4321);
+    // Tables this build or CPU does not support are nullptr and skipped
+    for (const KernelTable* table : { SimdKernels::Sse2(), SimdKernels::Avx2(), SimdKernels::Neon() }) {
+        if (table) {
+            std::printf("Checking %s kernels\n", table->name);
+            CheckTable(*table, rng);
+        }
+    }
+    // Get() must hand out one of the tables checked above (or the scalar one)
+    const KernelTable& selected = SimdKernels::Get();
+    CHECK(&selected == &SimdKernels::Scalar() || &selected == SimdKernels::Sse2() ||
+          &selected == SimdKernels::Avx2() || &selected == SimdKernels::Neon());
+    return TEST_RESULT();
+}
@@ -0,0 +1,104 @@
+// ---------------------------------------------
+// Tempo Detection Test
+// The tempo detectors must find the tempo of a synthetic onset train at every hop rate the
+// STFT stage can produce, since their history and lag ranges are sized in frames
+// ---------------------------------------------
+#include "test_common.h"
+#include "audio/beat_detection/beat_detector.h"
+#include "threading.h"
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Detected tempo may be off by this fraction of the true tempo (lag quantization at low hop rates)
+constexpr float TEMPO_TOLERANCE = 0.03f;
+
+// Tempo analysis runs every 2 s once the flux history holds enough frames; 24 s leaves
+// several analyses even at the lowest hop rate
+constexpr int SECONDS = 24;
+
+// Length of each onset in the low-band flux
+constexpr float ONSET_SECONDS = 0.08f;
+
+struct HopRate {
+    float sample_rate;
+    float hop_size;
+};
+
+// Feeds seconds of an onset train at bpm, continuing the stream at frame
+void Feed(IBeatDetector& detector, const HopRate& hop, float bpm, int seconds, size_t& frame) {
+    const float dt = hop.hop_size / hop.sample_rate;
+    const float period = 60.0f / bpm;
+    const std::vector<float> magnitudes; // Only the flux values drive these detectors
+    const size_t first_frame = frame;
+    for (int second = 0; second < seconds; second++) {
+        for (; static_cast<float>(frame - first_frame) * dt < static_cast<float>(second + 1); frame++) {
+            const float since_onset = std::fmod(static_cast<float>(frame - first_frame) * dt, period);
+            const float flux = since_onset < ONSET_SECONDS ? 1.0f : 0.0f;
+            detector.Process(magnitudes, flux, flux, dt);
+        }
+        // Give a queued tempo job time to finish, as the real-time stream would
+        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    }
+}
+
+void CheckResult(const IBeatDetector& detector, int algorithm, const HopRate& hop, float true_bpm, const char* what) {
+    const BeatDetectorResult result = detector.GetResult();
+    CHECK_MSG(result.tempo_detected && std::abs(result.tempo_bpm - true_bpm) <= TEMPO_TOLERANCE * true_bpm,
+              "algorithm %d, %.0f Hz / hop %.0f (%.2f frames/s), %s %.0f BPM: detected %s at %.2f BPM",
+              algorithm, hop.sample_rate, hop.hop_size, hop.sample_rate / hop.hop_size, what, true_bpm,
+              result.tempo_detected ? "yes" : "no", result.tempo_bpm);
+}
+
+void CheckTempo(int algorithm, WorkerPool& workers, const HopRate& hop, float true_bpm) {
+    std::unique_ptr<IBeatDetector> detector = IBeatDetector::Create(algorithm, workers);
+    detector->Start();
+    size_t frame = 0;
+    Feed(*detector, hop, true_bpm, SECONDS, frame);
+    CheckResult(*detector, algorithm, hop, true_bpm, "steady");
+    detector->Stop();
+}
+
+// A real change to double the tempo must be adopted once the history holds the new tempo
+void CheckTempoChange(int algorithm, WorkerPool& workers, const HopRate& hop, float from_bpm, float to_bpm) {
+    std::unique_ptr<IBeatDetector> detector = IBeatDetector::Create(algorithm, workers);
+    detector->Start();
+    size_t frame = 0;
+    Feed(*detector, hop, from_bpm, SECONDS, frame);
+    CheckResult(*detector, algorithm, hop, from_bpm, "before change to");
+    Feed(*detector, hop, to_bpm, SECONDS, frame);
+    CheckResult(*detector, algorithm, hop, to_bpm, "after change to");
+    detector->Stop();
+}
+
+} // namespace
+
+int main() {
+    WorkerPool workers;
+    workers.Start();
+
+    // The default 512-sample hop at 44.1/48 kHz, plus larger and smaller hops
+    const HopRate hop_rates[] = {
+        { 44100.0f, 1024.0f },  // 43.07 frames/s
+        { 48000.0f, 1024.0f },  // 46.88 frames/s
+        { 44100.0f, 512.0f },   // 86.13 frames/s
+        { 48000.0f, 512.0f },   // 93.75 frames/s
+        { 48000.0f, 256.0f },   // 187.5 frames/s
+    };
+    // Spectral flux with autocorrelation and the phase-locked tracker built on it
+    for (int algorithm : { 1, 2 }) {
+        for (const HopRate& hop : hop_rates) {
+            for (float bpm : { 100.0f, 123.0f, 140.0f }) {
+                CheckTempo(algorithm, workers, hop, bpm);
+            }
+            CheckTempoChange(algorithm, workers, hop, 70.0f, 140.0f);
+        }
+    }
+
+    workers.Stop();
+    return TEST_RESULT();
+}
@@ -0,0 +1,39 @@
+// ---------------------------------------------
+// Test Common
+// Minimal check macros shared by the CTest executables
+// ---------------------------------------------
+#pragma once
+#include <cstdio>
+
+namespace TestSupport {
+
+/// Number of failed checks so far in this executable
+inline int& Failures() {
+    static int failures = 0;
+    return failures;
+}
+
+} // namespace TestSupport
+
+// Records a failure (with file and line) and keeps going, so one run reports every mismatch
+#define CHECK(condition)                                                                     \
+    do {                                                                                     \
+        if (!(condition)) {                                                                  \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++TestSupport::Failures();                                                       \
+        }                                                                                    \
+    } while (0)
+
+// Same as CHECK with a printf-style context message (sizes, offsets, values)
+#define CHECK_MSG(condition, ...)                                                            \
+    do {                                                                                     \
+        if (!(condition)) {                                                                  \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s (", __FILE__, __LINE__, #condition); \
+            std::fprintf(stderr, __VA_ARGS__);                                               \
+            std::fprintf(stderr, ")\n");                                                     \
+            ++TestSupport::Failures();                                                       \
+        }                                                                                    \
+    } while (0)
+
+// Exit code for main(): CTest reports the test as failed when it is non-zero
+#define TEST_RESULT() (TestSupport::Failures() == 0 ? 0 : 1)
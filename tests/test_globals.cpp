@@ -0,0 +1,12 @@
+// ---------------------------------------------
+// Test Globals
+// Definitions normally provided by listeningway_addon.cpp, which is not linked into the tests
+// ---------------------------------------------
+#include "audio/analysis/audio_analysis.h"
+#include <atomic>
+#include <thread>
+
+// Referenced by AudioCaptureManager when it restarts the capture thread
+std::atomic_bool g_audio_thread_running = false;
+std::thread g_audio_thread;
+AudioAnalysisData g_audio_data;